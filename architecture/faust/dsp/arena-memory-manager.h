@@ -0,0 +1,181 @@
+/************************** BEGIN arena-memory-manager.h *******************
+FAUST Architecture File
+Copyright (C) 2003-2022 GRAME, Centre National de Creation Musicale
+---------------------------------------------------------------------
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+EXCEPTION : As a special exception, you may create a larger work
+that contains this FAUST architecture section and distribute
+that work under terms of your choice, so long as this FAUST
+architecture section is not modified.
+***************************************************************************/
+
+#ifndef __arena_memory_manager__
+#define __arena_memory_manager__
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#include "faust/dsp/dsp.h"
+
+/**
+ * A bump (arena) memory manager: all memory zones are taken in a single contiguous region,
+ * allocated and prefaulted at construction time. Instances created with it (by a factory
+ * using setMemoryManager, or by mydsp_poly for its voices) are then packed together,
+ * and their creation does not go through the system allocator nor trigger page faults.
+ *
+ * 'destroy' does not give memory back: the whole region is reused with 'reset'
+ * (when all instances have been deleted) and released when the manager is deleted.
+ * Zones that do not fit in the region are allocated with 'calloc'.
+ */
+struct arena_memory_manager : public dsp_memory_manager {
+
+    private:
+
+        char* fArena;
+        size_t fCapacity;
+        size_t fUsed;
+        size_t fOverflow;  // Number of zones allocated outside of the arena
+        bool fMapped;
+        bool fHugePages;
+
+        static const size_t kAlignment = 64;  // cache line
+        static const size_t kHugePageSize = 2 * 1024 * 1024;
+
+        static size_t roundUp(size_t size, size_t align)
+        {
+            return (size + align - 1) & ~(align - 1);
+        }
+
+        void allocateArena(int numa_node)
+        {
+        #ifndef _WIN32
+            size_t page_size = size_t(sysconf(_SC_PAGESIZE));
+            fCapacity = roundUp(fCapacity, (fHugePages) ? kHugePageSize : page_size);
+            void* arena = MAP_FAILED;
+        #ifdef MAP_HUGETLB
+            // Explicit huge pages need to be reserved in the system, otherwise fallback to standard pages
+            if (fHugePages) {
+                arena = mmap(nullptr, fCapacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            }
+        #endif
+            if (arena == MAP_FAILED) {
+                arena = mmap(nullptr, fCapacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            #ifdef MADV_HUGEPAGE
+                // Transparent huge pages
+                if (arena != MAP_FAILED && fHugePages) madvise(arena, fCapacity, MADV_HUGEPAGE);
+            #endif
+            }
+            if (arena != MAP_FAILED) {
+                fArena = static_cast<char*>(arena);
+                fMapped = true;
+            #if defined(__linux__) && defined(SYS_mbind)
+                // Bind on the given node, otherwise the pages are placed on the node of the thread prefaulting them
+                if (numa_node >= 0 && numa_node < int(sizeof(unsigned long) * 8)) {
+                    unsigned long mask = 1UL << numa_node;
+                    const int mpol_bind = 2;  // MPOL_BIND in <numaif.h>, not included to avoid the libnuma dependency
+                    syscall(SYS_mbind, fArena, fCapacity, mpol_bind, &mask, sizeof(mask) * 8, 0);
+                }
+            #endif
+                // Prefault all pages
+                for (size_t i = 0; i < fCapacity; i += page_size) {
+                    fArena[i] = 0;
+                }
+                return;
+            }
+        #endif
+            fArena = static_cast<char*>(calloc(1, fCapacity));
+            fMapped = false;
+        }
+
+        bool inArena(void* ptr)
+        {
+            return (static_cast<char*>(ptr) >= fArena) && (static_cast<char*>(ptr) < fArena + fCapacity);
+        }
+
+    public:
+
+        /**
+         * Create the arena.
+         * @param capacity - the arena size in bytes
+         * @param huge_pages - whether to use huge pages (explicit ones if reserved in the system, transparent ones otherwise)
+         * @param numa_node - the NUMA node to allocate the arena on (Linux only), or -1 to use the node
+         *                    of the calling thread (to be called from the thread which will compute the DSPs)
+         */
+        arena_memory_manager(size_t capacity, bool huge_pages = false, int numa_node = -1)
+        :fArena(nullptr), fCapacity(capacity), fUsed(0), fOverflow(0), fMapped(false), fHugePages(huge_pages)
+        {
+            allocateArena(numa_node);
+            if (!fArena) fCapacity = 0;
+        }
+
+        virtual ~arena_memory_manager()
+        {
+        #ifndef _WIN32
+            if (fMapped) {
+                munmap(fArena, fCapacity);
+                return;
+            }
+        #endif
+            free(fArena);
+        }
+
+        virtual void* allocate(size_t size)
+        {
+            size_t aligned_size = roundUp(size, kAlignment);
+            if (fUsed + aligned_size <= fCapacity) {
+                void* ptr = fArena + fUsed;
+                fUsed += aligned_size;
+                // Memory may have been used before 'reset'
+                memset(ptr, 0, size);
+                return ptr;
+            } else {
+                fOverflow++;
+                return calloc(1, size);
+            }
+        }
+
+        virtual void destroy(void* ptr)
+        {
+            if (!inArena(ptr)) free(ptr);
+        }
+
+        /**
+         * Reuse the whole arena, to be called when all the instances it contains have been deleted.
+         */
+        void reset()
+        {
+            fUsed = 0;
+            fOverflow = 0;
+        }
+
+        size_t getCapacity() { return fCapacity; }
+        size_t getUsed() { return fUsed; }
+        size_t getOverflow() { return fOverflow; }
+
+};
+
+#endif
+/************************** END arena-memory-manager.h **************************/
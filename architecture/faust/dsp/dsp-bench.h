@@ -39,6 +39,8 @@ architecture section is not modified.
 #include <unistd.h>
 #include <stdlib.h>
 #include <time.h>
+#include <string>
+#include <sstream>
 
 #include "faust/dsp/dsp.h"
 #include "faust/gui/MapUI.h"
@@ -47,6 +49,8 @@ architecture section is not modified.
 // number of vectors in BIG buffer (should exceed cache)
 #define NBV 4096
 #define BENCH_SAMPLE_RATE 44100.0
+// size of the buffer written before each 'compute' call in cold cache mode (should exceed the last level cache)
+#define BENCH_FLUSH_SIZE (32 * 1024 * 1024)
 
 template <typename VAL_TYPE>
 void FAUSTBENCH_LOG(VAL_TYPE val)
@@ -59,6 +63,73 @@ void FAUSTBENCH_LOG(VAL_TYPE val)
     }
 }
 
+/*
+    Latency distribution of the 'compute' calls (all durations in microseconds)
+*/
+struct latency_stats {
+
+    std::string fName;
+    int fBufferSize = 0;
+    int fCount = 0;             // number of measures the percentiles are computed on
+    bool fColdCache = false;    // whether caches were flushed before each call
+    double fDeadline = 0.;      // duration of a buffer at BENCH_SAMPLE_RATE
+    double fFirst = 0.;         // first call of the measure
+    double fMin = 0.;
+    double fMean = 0.;
+    double fP50 = 0.;
+    double fP90 = 0.;
+    double fP99 = 0.;
+    double fP999 = 0.;
+    double fMax = 0.;
+
+    void print(FILE* file) const
+    {
+        fprintf(file, "%s : bs = %d%s, p50 = %.2f, p90 = %.2f, p99 = %.2f, p99.9 = %.2f, max = %.2f, first = %.2f usec (deadline %.2f usec, max %.1f %%)\n",
+                fName.c_str(), fBufferSize, (fColdCache ? " (cold cache)" : ""),
+                fP50, fP90, fP99, fP999, fMax, fFirst, fDeadline, 100. * fMax / fDeadline);
+    }
+
+    void printJSON(FILE* file) const
+    {
+        fprintf(file, "  { \"name\" : \"%s\", \"buffer_size\" : %d, \"cold_cache\" : %s, \"count\" : %d, \"deadline\" : %g, "
+                "\"first\" : %g, \"min\" : %g, \"mean\" : %g, \"p50\" : %g, \"p90\" : %g, \"p99\" : %g, \"p99.9\" : %g, \"max\" : %g }",
+                fName.c_str(), fBufferSize, (fColdCache ? "true" : "false"), fCount, fDeadline,
+                fFirst, fMin, fMean, fP50, fP90, fP99, fP999, fMax);
+    }
+
+};
+
+/*
+    Parse the '-latency' comma separated list of buffer sizes, ignoring the invalid ones.
+*/
+inline std::vector<int> parseSizes(const std::string& sizes)
+{
+    std::vector<int> res;
+    std::stringstream reader(sizes);
+    std::string size;
+    while (getline(reader, size, ',')) {
+        if (atoi(size.c_str()) > 0) res.push_back(atoi(size.c_str()));
+    }
+    return res;
+}
+
+/*
+    Write a JSON array of latency distributions, returns false if the file cannot be written.
+*/
+inline bool writeLatencyStats(const std::string& filename, const std::vector<latency_stats>& stats)
+{
+    FILE* file = fopen(filename.c_str(), "w");
+    if (!file) return false;
+    fprintf(file, "[\n");
+    for (size_t i = 0; i < stats.size(); i++) {
+        stats[i].printJSON(file);
+        fprintf(file, "%s\n", ((i + 1 < stats.size()) ? "," : ""));
+    }
+    fprintf(file, "]\n");
+    fclose(file);
+    return true;
+}
+
 /*
     A class to do do timing measurements
 */
@@ -80,6 +151,9 @@ class time_bench_real {
         uint64_t* fStarts;
         uint64_t* fStops;
     
+        // Duration in ticks of the first measure
+        uint64_t fFirst;
+    
         struct timeval fTv1;
         struct timeval fTv2;
     
@@ -153,6 +227,15 @@ class time_bench_real {
             while (a != b) { r += *a++; n++; }
             return (n > 0) ? r/n : 0;
         }
+    
+        /**
+         * Returns the 'percentile' (in 0..100) value of a sorted vector of measures (nearest-rank method)
+         */
+        uint64_t percentileValue(const std::vector<uint64_t>& V, double percentile)
+        {
+            size_t rank = size_t(std::ceil(percentile / 100. * double(V.size())));
+            return V[std::min(V.size(), std::max(rank, size_t(1))) - 1];
+        }
   
     public:
     
@@ -163,6 +246,7 @@ class time_bench_real {
             fMeasure = 0;
             fFirstRDTSC = 0;
             fLastRDTSC = 0;
+            fFirst = 0;
             fStarts = new uint64_t[fCount];
             fStops = new uint64_t[fCount];
         }
@@ -175,7 +259,12 @@ class time_bench_real {
     
         void startMeasure() { fStarts[fMeasure % fCount] = getTicks(); }
     
-        void stopMeasure() { fStops[fMeasure % fCount] = getTicks(); fMeasure++; }
+        void stopMeasure()
+        {
+            fStops[fMeasure % fCount] = getTicks();
+            if (fMeasure == 0) fFirst = fStops[0] - fStarts[0];
+            fMeasure++;
+        }
         
         void openMeasure()
         {
@@ -246,6 +335,31 @@ class time_bench_real {
                     megapersec(bsize, ichans+ochans, meaval100));
         }
     
+        /**
+         * Fill the latency distribution (in microseconds) of the fCount last measures
+         */
+        void getLatencyStats(latency_stats& stats)
+        {
+            assert(fMeasure > fCount);
+            std::vector<uint64_t> V(fCount);
+            
+            for (int i = 0; i < fCount; i++) {
+                V[i] = fStops[i] - fStarts[i];
+            }
+            
+            sort(V.begin(), V.end());
+            
+            stats.fCount = fCount;
+            stats.fFirst = rdtsc2sec(fFirst) * 1e6;
+            stats.fMin = rdtsc2sec(V[0]) * 1e6;
+            stats.fMean = rdtsc2sec(meanValue(V.begin(), V.end())) * 1e6;
+            stats.fP50 = rdtsc2sec(percentileValue(V, 50.)) * 1e6;
+            stats.fP90 = rdtsc2sec(percentileValue(V, 90.)) * 1e6;
+            stats.fP99 = rdtsc2sec(percentileValue(V, 99.)) * 1e6;
+            stats.fP999 = rdtsc2sec(percentileValue(V, 99.9)) * 1e6;
+            stats.fMax = rdtsc2sec(V[fCount - 1]) * 1e6;
+        }
+    
         bool isRunning() { return (fMeasure <= (fCount + fSkip)); }
     
         int getCount()
@@ -342,9 +456,16 @@ class measure_dsp_real : public decorator_dsp {
         int fCount;
         bool fControl;
         RandomControlUI fRandomUI;
+        char* fFlushBuffer;
+        size_t fFlushSize;
+        double fDurationInSec;
     
         void init()
         {
+            fFlushBuffer = nullptr;
+            fFlushSize = 0;
+            fDurationInSec = 0.;
+            
             fDSP->init(BENCH_SAMPLE_RATE);
             fDSP->buildUserInterface(&fRandomUI);
             
@@ -399,6 +520,37 @@ class measure_dsp_real : public decorator_dsp {
             return (err != -1);
         }
     
+        /**
+         * Allocate the time_bench_real object with the proper 'count' number of measures for fDurationInSec
+         */
+        void estimateCount(bool trace)
+        {
+            // Creates a first time_bench_real object to estimate the proper 'count' number of measure to do later
+            fBench = new time_bench_real<REAL>(1000, 10);
+            measure();
+            double duration = fBench->measureDurationUsec();
+            if (trace) {
+                fprintf(stdout, "Duration %f\n",  (duration / 1e6));
+                if (fControl) fprintf(stdout, "Random control is on\n");
+            }
+            fCount = int(1000 * (fDurationInSec * 1e6 / duration));
+            delete fBench;
+            
+            // Then allocate final time_bench_real object with proper 'count' parameter
+            fBench = new time_bench_real<REAL>(fCount, 10);
+        }
+    
+        /**
+         * Evict the DSP state, the audio buffers and the code from the caches, by writing one byte per cache line
+         * of a buffer larger than the last level cache.
+         */
+        void flushCache()
+        {
+            for (size_t i = 0; i < fFlushSize; i += 64) {
+                fFlushBuffer[i]++;
+            }
+        }
+    
     public:
     
         /**
@@ -453,19 +605,8 @@ class measure_dsp_real : public decorator_dsp {
         {
             init();
             
-            // Creates a first time_bench_real object to estimate the proper 'count' number of measure to do later
-            fBench = new time_bench_real<REAL>(1000, 10);
-            measure();
-            double duration = fBench->measureDurationUsec();
-            if (trace) {
-                fprintf(stdout, "Duration %f\n",  (duration / 1e6));
-                if (control) fprintf(stdout, "Random control is on\n");
-            }
-            fCount = int(1000 * (duration_in_sec * 1e6 / duration));
-            delete fBench;
-            
-            // Then allocate final time_bench_real object with proper 'count' parameter
-            fBench = new time_bench_real<REAL>(fCount, 10);
+            fDurationInSec = duration_in_sec;
+            estimateCount(trace);
         }
     
         virtual ~measure_dsp_real()
@@ -483,6 +624,7 @@ class measure_dsp_real : public decorator_dsp {
             delete [] fAllOutputs;
             
             delete fBench;
+            delete [] fFlushBuffer;
             // DSP is deallocated by the decorator_dsp class.
         }
     
@@ -494,6 +636,8 @@ class measure_dsp_real : public decorator_dsp {
             AVOIDDENORMALS;
             // Possibly update all controllers
             if (fControl) fRandomUI.update();
+            // Possibly start from cold caches
+            if (fFlushBuffer) flushCache();
             // Only measure the 'compute' method
             fBench->startMeasure();
             fDSP->compute(count, reinterpret_cast<FAUSTFLOAT**>(inputs), reinterpret_cast<FAUSTFLOAT**>(outputs));
@@ -564,6 +708,42 @@ class measure_dsp_real : public decorator_dsp {
             fBench->printStats(applname, fBufferSize, fDSP->getNumInputs(), fDSP->getNumOutputs());
         }
     
+        /**
+         * Returns the latency distribution of the 'compute' calls of the last measure.
+         *
+         * @param name - the name of the measured DSP (or of its compilation options)
+         */
+        latency_stats getLatencyStats(const std::string& name = "")
+        {
+            latency_stats stats;
+            stats.fName = name;
+            stats.fBufferSize = fBufferSize;
+            stats.fColdCache = (fFlushBuffer != nullptr);
+            stats.fDeadline = double(fBufferSize) * 1e6 / BENCH_SAMPLE_RATE;
+            fBench->getLatencyStats(stats);
+            return stats;
+        }
+    
+        /**
+         * Flush the caches before each 'compute' call, so that the measures give the cost
+         * of a buffer processed after the audio thread has been preempted. The flush is not measured,
+         * but is part of the measure duration, so 'getCPULoad' is meaningless in this mode.
+         * With the 'duration_in_sec' constructor, the number of measures is estimated again.
+         *
+         * @param size - the size in bytes of the buffer written before each call (0 to deactivate)
+         */
+        void setColdCache(size_t size = BENCH_FLUSH_SIZE)
+        {
+            delete [] fFlushBuffer;
+            fFlushSize = size;
+            fFlushBuffer = (size > 0) ? new char[size]() : nullptr;
+            // Flushing makes each call longer, so the 'count' number of measures has to be estimated again
+            if (fDurationInSec > 0.) {
+                delete fBench;
+                estimateCount(false);
+            }
+        }
+    
         bool isRunning() { return fBench->isRunning(); }
     
         float getCPULoad()
@@ -30,13 +30,135 @@ architecture section is not modified.
 #include <pwd.h>
 #include <unistd.h>
 #include <typeinfo>
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 #include "faust/dsp/llvm-dsp.h"
 #include "faust/dsp/dsp-bench.h"
+#include "faust/gui/SimpleParser.h"
 
 typedef std::vector<std::string> TOption;
 typedef std::vector<TOption> TOptionTable;
 
+/*
+    An entry of the optimizer results database, a JSON array of:
+    { "sha_key" : "...", "target" : "...", "buffer_size" : 512, "precision" : "float", "options" : [...], "mbytes" : 0.0, "cpu" : 0.0 }
+*/
+struct TOptimizerResult {
+    
+    std::string fSHAKey;
+    std::string fTarget;
+    std::string fPrecision;
+    int fBufferSize = 0;
+    TOption fOptions;
+    double fMBytes = 0.;
+    double fCPU = 0.;
+    
+    bool sameKey(const TOptimizerResult& res) const
+    {
+        return (fSHAKey == res.fSHAKey)
+            && (fTarget == res.fTarget)
+            && (fPrecision == res.fPrecision)
+            && (fBufferSize == res.fBufferSize);
+    }
+    
+    static bool parse(const char*& p, TOptimizerResult& res)
+    {
+        if (!parseChar(p, '{')) return false;
+        do {
+            std::string key, value;
+            double number = 0.;
+            if (!parseDQString(p, key) || !parseChar(p, ':')) return false;
+            if (key == "options") {
+                if (!parseList(p, res.fOptions)) return false;
+            } else if (parseDQString(p, value)) {
+                if (key == "sha_key") {
+                    res.fSHAKey = value;
+                } else if (key == "target") {
+                    res.fTarget = value;
+                } else if (key == "precision") {
+                    res.fPrecision = value;
+                }
+            } else if (parseDouble(p, number)) {
+                if (key == "buffer_size") {
+                    res.fBufferSize = int(number);
+                } else if (key == "mbytes") {
+                    res.fMBytes = number;
+                } else if (key == "cpu") {
+                    res.fCPU = number;
+                }
+            } else {
+                return false;
+            }
+        } while (tryChar(p, ','));
+        return parseChar(p, '}');
+    }
+    
+    void print(FILE* file) const
+    {
+        fprintf(file, "  { \"sha_key\" : \"%s\", \"target\" : \"%s\", \"buffer_size\" : %d, \"precision\" : \"%s\", \"options\" : [",
+                fSHAKey.c_str(), fTarget.c_str(), fBufferSize, fPrecision.c_str());
+        for (size_t i = 0; i < fOptions.size(); i++) {
+            fprintf(file, "%s\"%s\"", ((i > 0) ? ", " : ""), fOptions[i].c_str());
+        }
+        fprintf(file, "], \"mbytes\" : %g, \"cpu\" : %g }", fMBytes, fCPU);
+    }
+    
+};
+
+/*
+    Read all entries of a results database, returns false if the file cannot be read or parsed.
+*/
+static bool readOptimizerDatabase(const std::string& filename, std::vector<TOptimizerResult>& results)
+{
+    std::ifstream reader(filename);
+    if (!reader.is_open()) return false;
+    std::stringstream buffer;
+    buffer << reader.rdbuf();
+    std::string content = buffer.str();
+    const char* p = content.c_str();
+    if (!parseChar(p, '[')) return false;
+    if (tryChar(p, ']')) return true;
+    do {
+        TOptimizerResult res;
+        if (!TOptimizerResult::parse(p, res)) return false;
+        results.push_back(res);
+    } while (tryChar(p, ','));
+    return parseChar(p, ']');
+}
+
+/*
+    Add or replace an entry in a results database.
+*/
+static bool writeOptimizerDatabase(const std::string& filename, const TOptimizerResult& res)
+{
+    std::vector<TOptimizerResult> results;
+    readOptimizerDatabase(filename, results);
+    auto it = std::find_if(results.begin(), results.end(), [&](const TOptimizerResult& r) { return r.sameKey(res); });
+    if (it != results.end()) {
+        *it = res;
+    } else {
+        results.push_back(res);
+    }
+    FILE* file = fopen(filename.c_str(), "w");
+    if (!file) return false;
+    fprintf(file, "[\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        results[i].print(file);
+        fprintf(file, "%s\n", ((i + 1 < results.size()) ? "," : ""));
+    }
+    fprintf(file, "]\n");
+    fclose(file);
+    return true;
+}
+
 /*
     A class to find optimal Faust compiler parameters for a given DSP.
 */
@@ -51,8 +173,6 @@ class dsp_optimizer_real {
         const char** fArgv;
     
         int fOptLevel;      
-        llvm_dsp_factory* fFactory;
-        llvm_dsp* fDSP;
     
         int fRun;
         int fCount;
@@ -62,25 +182,38 @@ class dsp_optimizer_real {
         int fDownSampling;
         int fUpSampling;
         int fFilter;
+        bool fParallel;
     
         std::string fFilename;
         std::string fInput;
         std::string fTarget;
         std::string fError;
+        std::string fDatabase;
     
         TOptionTable fOptionsTable;
     
-        std::pair<double, double> bench(int run)
+        // Key and result found in the database, if any
+        TOptimizerResult fResult;
+        bool fCached;
+    
+        std::pair<double, double> bench(llvm_dsp_factory* factory, int count, int run)
         {
+            llvm_dsp* DSP = factory->createDSPInstance();
+            if (!DSP) {
+                fprintf(stderr, "Cannot create instance...\n");
+                return std::make_pair(0., 0.);
+            }
+            // DSP is deallocated by measure_dsp
+        
             // First call with fCount = -1 will be used to estimate fCount by giving the wanted measure duration
             if (fCount == -1) {
-                measure_dsp_real<REAL> mes(fDSP, fBufferSize, 5., fTrace, fControl, fDownSampling, fUpSampling, fFilter);
+                measure_dsp_real<REAL> mes(DSP, fBufferSize, 5., fTrace, fControl, fDownSampling, fUpSampling, fFilter);
                 mes.measure();
                 // fCount is kept from the first duration measure
                 fCount = mes.getCount();
                 return std::make_pair(mes.getStats(), mes.getCPULoad());
             } else {
-                measure_dsp_real<REAL> mes(fDSP, fBufferSize, fCount, fTrace, fControl, fDownSampling, fUpSampling, fFilter);
+                measure_dsp_real<REAL> mes(DSP, fBufferSize, count, fTrace, fControl, fDownSampling, fUpSampling, fFilter);
                 for (int i = 0; i < run; i++) {
                     mes.measure();
                     if (fTrace) {
@@ -230,7 +363,7 @@ class dsp_optimizer_real {
             return res_item;
         }
         
-        bool computeOne(const TOption& item, int run, std::pair<double, double>& res)
+        llvm_dsp_factory* createFactory(const TOption& item)
         {
             int argc = 0;
             const char* argv[64];
@@ -239,52 +372,256 @@ class dsp_optimizer_real {
             }
             argv[argc] = nullptr;  // NULL terminated argv
             
+            std::string error;
+            llvm_dsp_factory* factory = nullptr;
             if (fInput == "") {
-                fFactory = createDSPFactoryFromFile(fFilename.c_str(), argc, argv, fTarget, fError, fOptLevel);
+                factory = createDSPFactoryFromFile(fFilename.c_str(), argc, argv, fTarget, error, fOptLevel);
             } else {
-                fFactory = createDSPFactoryFromString("FaustDSP", fInput, argc, argv, fTarget, fError, fOptLevel);
+                factory = createDSPFactoryFromString("FaustDSP", fInput, argc, argv, fTarget, error, fOptLevel);
             }
             
-            if (!fFactory) {
-                fprintf(stderr, "Cannot create factory : %s\n", fError.c_str());
-                return false;
-            }
-            
-            fDSP = fFactory->createDSPInstance();
-            if (!fDSP) {
-                fprintf(stderr, "Cannot create instance...\n");
-                return false;
+            if (!factory) {
+                fprintf(stderr, "Cannot create factory : %s\n", error.c_str());
+                fError = error;
             }
+            return factory;
+        }
+    
+        bool computeOne(const TOption& item, int run, std::pair<double, double>& res)
+        {
+            llvm_dsp_factory* factory = createFactory(item);
+            if (!factory) return false;
             
             if (fTrace) printItem(item);
+            res = bench(factory, fCount, run);
             
-            res = bench(run);
-            // fDSP is deallocated by bench calling measure_dsp
-            
-            deleteDSPFactory(fFactory);
-            fFactory = nullptr;
-            fDSP = nullptr;
-            
+            deleteDSPFactory(factory);
             return true;
         }
     
+        // Pin the calling thread on the last core (used to measure) or on all the other ones (used to compile)
+        void setThreadAffinity(bool measure)
+        {
+        #ifdef __linux__
+            int cores = std::thread::hardware_concurrency();
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            if (measure) {
+                CPU_SET(cores - 1, &set);
+            } else {
+                for (int i = 0; i < cores - 1; i++) CPU_SET(i, &set);
+            }
+            pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set);
+        #endif
+        }
+    
+        void resetThreadAffinity()
+        {
+        #ifdef __linux__
+            int cores = std::thread::hardware_concurrency();
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (int i = 0; i < cores; i++) CPU_SET(i, &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set);
+        #endif
+        }
+    
+        void compileAll(const TOptionTable& options, std::vector<std::promise<llvm_dsp_factory*> >& factories)
+        {
+            for (size_t i = 0; i < options.size(); i++) {
+                factories[i].set_value(createFactory(addArgvItems(options[i], fArgc, fArgv)));
+            }
+        }
+    
+        /*
+            Successive halving: all candidates are first measured on a short run, only the best half
+            is kept and measured again on a twice longer run, until the remaining one is measured on the full run.
+            When several cores are available, factories are compiled in a separate thread while
+            the already compiled ones are measured on a dedicated core.
+        */
         std::tuple<double, double, TOption> findOptimizedParametersAux(const TOptionTable& options)
         {
-            std::vector<std::tuple<int, double, double> > table_res;
-            std::pair<double, double> res = {0., 0.};
+            std::vector<std::promise<llvm_dsp_factory*> > promises(options.size());
+            std::vector<std::shared_future<llvm_dsp_factory*> > factories;
+            for (auto& promise : promises) {
+                factories.push_back(promise.get_future().share());
+            }
             
-            for (int i = 0; i < options.size(); i++) {
-                if (computeOne(addArgvItems(options[i], fArgc, fArgv), fRun, res)) {
-                    table_res.push_back(std::make_tuple(i, res.first, res.second));
-                } else {
-                    fprintf(stderr, "computeOne error...\n");
+            std::thread compiler;
+            if (fParallel) {
+                compiler = std::thread([&]() { setThreadAffinity(false); compileAll(options, promises); });
+                setThreadAffinity(true);
+            } else {
+                compileAll(options, promises);
+            }
+            
+            // Join the compiler thread and delete the factories on every exit path, exceptions included
+            struct Cleanup {
+                std::function<void()> fFun;
+                ~Cleanup() { fFun(); }
+            } cleanup { [&]() {
+                if (compiler.joinable()) {
+                    compiler.join();
+                    resetThreadAffinity();
+                }
+                for (auto& factory : factories) {
+                    if (factory.get()) deleteDSPFactory(factory.get());
+                }
+            } };
+            
+            int rounds = 0;
+            for (size_t size = options.size(); size > 1; size = (size + 1) / 2) rounds++;
+            
+            std::vector<int> candidates;
+            for (size_t i = 0; i < options.size(); i++) candidates.push_back(int(i));
+            
+            std::vector<std::tuple<int, double, double> > table_res;
+            for (int round = 0; round <= rounds; round++) {
+                int count = std::min(fCount, std::max(fCount >> (rounds - round), 1000));
+                int run = (round == rounds) ? fRun : 1;
+                table_res.clear();
+                for (int index : candidates) {
+                    llvm_dsp_factory* factory = factories[index].get();
+                    if (factory) {
+                        if (fTrace) printItem(options[index]);
+                        std::pair<double, double> res = bench(factory, count, run);
+                        table_res.push_back(std::make_tuple(index, res.first, res.second));
+                    } else {
+                        fprintf(stderr, "computeOne error...\n");
+                    }
+                }
+                sort(table_res.begin(), table_res.end(), compareFun);
+                candidates.clear();
+                for (size_t i = 0; i < (table_res.size() + 1) / 2; i++) {
+                    candidates.push_back(std::get<0>(table_res[i]));
                 }
             }
             
-            sort(table_res.begin(), table_res.end(), compareFun);
+            if (table_res.size() == 0) {
+                throw std::runtime_error("dsp_optimizer : none of the tested options could be compiled and measured");
+            }
             return std::make_tuple(std::get<1>(table_res[0]), std::get<2>(table_res[0]), options[std::get<0>(table_res[0])]);
         }
 
+        // Compare the current best options with the same options extended with each of the 'extra' items
+        std::tuple<double, double, TOption> refineWith(const std::tuple<double, double, TOption>& best, const TOptionTable& extra)
+        {
+            TOptionTable options_table;
+            options_table.push_back(std::get<2>(best));
+            for (const auto& item : extra) {
+                TOption option = std::get<2>(best);
+                option.insert(option.end(), item.begin(), item.end());
+                options_table.push_back(option);
+            }
+            return findOptimizedParametersAux(options_table);
+        }
+    
+        // LLVM loop hints and pipeline knobs, explored one after the other
+        std::tuple<double, double, TOption> findOptimizedLLVMParameters(const std::tuple<double, double, TOption>& best)
+        {
+            std::tuple<double, double, TOption> res = best;
+            
+            if (std::get<2>(res)[0] == "-vec") {
+                if (fTrace) fprintf(stdout, "Refined with -lvw and -lic\n");
+                TOptionTable width_table;
+                for (int width = 2; width <= 16; width *= 2) {
+                    width_table.push_back({ "-lvw", std::to_string(width) });
+                }
+                res = refineWith(res, width_table);
+                TOptionTable interleave_table;
+                for (int count = 1; count <= 4; count *= 2) {
+                    interleave_table.push_back({ "-lic", std::to_string(count) });
+                }
+                res = refineWith(res, interleave_table);
+            }
+            
+            if (fTrace) fprintf(stdout, "Refined with -luc\n");
+            TOptionTable unroll_table;
+            for (int count = 1; count <= 8; count *= 2) {
+                unroll_table.push_back({ "-luc", std::to_string(count) });
+            }
+            res = refineWith(res, unroll_table);
+            
+            if (fTrace) fprintf(stdout, "Refined with -lslp\n");
+            res = refineWith(res, { { "-lslp" } });
+            
+            // -lit is rejected by a libfaust built with LLVM 14
+            if (getLLVMVersion() == 14) return res;
+            if (fTrace) fprintf(stdout, "Refined with -lit\n");
+            return refineWith(res, { { "-lit", "100" }, { "-lit", "500" }, { "-lit", "1000" } });
+        }
+    
+        // LLVM major version libfaust was built with, read from the "x.y.z (LLVM a.b.c)" version string
+        static int getLLVMVersion()
+        {
+            std::string version = getCLibFaustVersion();
+            size_t pos = version.find("LLVM ");
+            return (pos != std::string::npos) ? std::atoi(version.c_str() + pos + 5) : 0;
+        }
+
+        // Exhaustive table first, then refinement steps starting from the current best
+        std::tuple<double, double, TOption> searchOptimizedParameters()
+        {
+            if (fTrace) fprintf(stdout, "Discover best parameters option\n");
+            std::tuple<double, double, TOption> best1 = findOptimizedParametersAux(fOptionsTable);
+            
+            if (fTrace) fprintf(stdout, "Refined with -mcd\n");
+            TOptionTable options_table;
+        
+            // Start from 0
+            TOption best2 = std::get<2>(best1);
+            best2.push_back("-mcd");
+            best2.push_back("0");
+            options_table.push_back(best2);
+            for (int size = 2; size <= 256; size *= 2) {
+                TOption best2 = std::get<2>(best1);
+                best2.push_back("-mcd");
+                best2.push_back(std::to_string(size));
+                options_table.push_back(best2);
+            }
+            
+            if (fNeedExp10) {
+                if (fTrace) fprintf(stdout, "Use -exp10\n");
+                TOption t0_exp10;
+                t0_exp10.push_back("-exp10");
+                options_table.push_back(t0_exp10);
+            }
+            
+            std::tuple<double, double, TOption> best3 = findOptimizedParametersAux(options_table);
+           
+            if (std::get<2>(best3)[0] == "-vec") {
+                if (fTrace) fprintf(stdout, "Check with -g or -dfs\n");
+                // Current best
+                TOptionTable options_table1;
+                {
+                    TOption best2 = std::get<2>(best3);
+                    options_table1.push_back(best2);
+                }
+                // Add -g
+                {
+                    TOption best2 = std::get<2>(best3);
+                    best2.push_back("-g");
+                    options_table1.push_back(best2);
+                }
+                // Add -dfs
+                {
+                    TOption best2 = std::get<2>(best3);
+                    best2.push_back("-dfs");
+                    options_table1.push_back(best2);
+                }
+                // Add -g and -dfs
+                {
+                    TOption best2 = std::get<2>(best3);
+                    best2.push_back("-g");
+                    best2.push_back("-dfs");
+                    options_table1.push_back(best2);
+                }
+                return findOptimizedLLVMParameters(findOptimizedParametersAux(options_table1));
+            } else {
+                return findOptimizedLLVMParameters(best3);
+            }
+        }
+
         static bool compareFun(std::tuple<int, double, double> i, std::tuple<int, double, double> j)
         {
             return (std::get<1>(i) > std::get<1>(j));
@@ -302,7 +639,9 @@ class dsp_optimizer_real {
                   bool control,
                   int ds,
                   int us,
-                  int filter)
+                  int filter,
+                  const std::string& database,
+                  bool parallel)
         {
             fFilename = filename;
             fInput = input;
@@ -319,9 +658,34 @@ class dsp_optimizer_real {
             fDownSampling = ds;
             fUpSampling = us;
             fFilter = filter;
+            fDatabase = database;
+            fParallel = parallel && (std::thread::hardware_concurrency() > 1);
+            fCached = false;
             
             init();
             
+            // The database key: DSP SHA key (computed with the additional options only), machine target, buffer size and sample precision
+            llvm_dsp_factory* factory = createFactory(addArgvItems(TOption(), fArgc, fArgv));
+            if (!factory) return false;
+            fResult.fSHAKey = factory->getSHAKey();
+            fResult.fTarget = (fTarget == "") ? getDSPMachineTarget() : fTarget;
+            fResult.fBufferSize = fBufferSize;
+            fResult.fPrecision = (sizeof(REAL) == sizeof(double)) ? "double" : "float";
+            deleteDSPFactory(factory);
+            
+            if (fDatabase != "") {
+                std::vector<TOptimizerResult> results;
+                readOptimizerDatabase(fDatabase, results);
+                for (const auto& res : results) {
+                    if (res.sameKey(fResult)) {
+                        if (fTrace) fprintf(stdout, "Found in '%s' database\n", fDatabase.c_str());
+                        fResult = res;
+                        fCached = true;
+                        return true;
+                    }
+                }
+            }
+            
             if (fTrace) fprintf(stdout, "Estimate timing parameters\n");
             std::pair<double, double> res1 = {0., 0.};
             if (!computeOne(addArgvItems(fOptionsTable[0], fArgc, fArgv), 1, res1)) {
@@ -356,6 +720,8 @@ class dsp_optimizer_real {
          * @param us - upsampling factor
          * @param filter - filter type
          * since the maximum value may change with new LLVM versions)
+         * @param database - the JSON file where results are read and written (empty string means no database)
+         * @param parallel - whether to compile candidates in a separate thread, while measuring on a dedicated core
          */
         dsp_optimizer_real(const std::string& filename,
                            int argc,
@@ -368,9 +734,11 @@ class dsp_optimizer_real {
                            bool control = false,
                            int ds = 0,
                            int us = 0,
-                           int filter = 0)
+                           int filter = 0,
+                           const std::string& database = "",
+                           bool parallel = true)
         {
-            if (!init(filename, "", argc, argv, target, buffer_size, run, opt_level, trace, control, ds, us, filter)) {
+            if (!init(filename, "", argc, argv, target, buffer_size, run, opt_level, trace, control, ds, us, filter, database, parallel)) {
                 throw std::bad_alloc();
             }
         }
@@ -379,70 +747,28 @@ class dsp_optimizer_real {
         {}
     
         /**
-         * Returns the best compilations parameters.
+         * Returns the best compilations parameters, read from the database if it already contains them
+         * for this DSP, or searched then added to the database.
          *
          * @return the best result (in Megabytes/seconds) and DSP CPU (in 0..1), and compilation parameters in a vector.
          */
         std::tuple<double, double, TOption> findOptimizedParameters()
         {
-            if (fTrace) fprintf(stdout, "Discover best parameters option\n");
-            std::tuple<double, double, TOption> best1 = findOptimizedParametersAux(fOptionsTable);
-            
-            if (fTrace) fprintf(stdout, "Refined with -mcd\n");
-            TOptionTable options_table;
-        
-            // Start from 0
-            TOption best2 = std::get<2>(best1);
-            best2.push_back("-mcd");
-            best2.push_back("0");
-            options_table.push_back(best2);
-            for (int size = 2; size <= 256; size *= 2) {
-                TOption best2 = std::get<2>(best1);
-                best2.push_back("-mcd");
-                best2.push_back(std::to_string(size));
-                options_table.push_back(best2);
+            if (fCached) {
+                return std::make_tuple(fResult.fMBytes, fResult.fCPU, fResult.fOptions);
             }
-            
-            if (fNeedExp10) {
-                if (fTrace) fprintf(stdout, "Use -exp10\n");
-                TOption t0_exp10;
-                t0_exp10.push_back("-exp10");
-                options_table.push_back(t0_exp10);
-            }
-            
-            std::tuple<double, double, TOption> best3 = findOptimizedParametersAux(options_table);
-           
-            if (std::get<2>(best3)[0] == "-vec") {
-                if (fTrace) fprintf(stdout, "Check with -g or -dfs\n");
-                // Current best
-                TOptionTable options_table1;
-                {
-                    TOption best2 = std::get<2>(best3);
-                    options_table1.push_back(best2);
-                }
-                // Add -g
-                {
-                    TOption best2 = std::get<2>(best3);
-                    best2.push_back("-g");
-                    options_table1.push_back(best2);
-                }
-                // Add -dfs
-                {
-                    TOption best2 = std::get<2>(best3);
-                    best2.push_back("-dfs");
-                    options_table1.push_back(best2);
-                }
-                // Add -g and -dfs
-                {
-                    TOption best2 = std::get<2>(best3);
-                    best2.push_back("-g");
-                    best2.push_back("-dfs");
-                    options_table1.push_back(best2);
+            std::tuple<double, double, TOption> res = searchOptimizedParameters();
+            if (fDatabase != "") {
+                fResult.fMBytes = std::get<0>(res);
+                fResult.fCPU = std::get<1>(res);
+                fResult.fOptions = std::get<2>(res);
+                if (writeOptimizerDatabase(fDatabase, fResult)) {
+                    fCached = true;
+                } else {
+                    fprintf(stderr, "Cannot write '%s' database\n", fDatabase.c_str());
                 }
-                return findOptimizedParametersAux(options_table1);
-            } else {
-                return best3;
             }
+            return res;
         }
     
         /**
@@ -469,12 +795,15 @@ class dsp_optimizer : public dsp_optimizer_real<FAUSTFLOAT> {
                        bool control = false,
                        int ds = 0,
                        int us = 0,
-                       int filter = 0)
+                       int filter = 0,
+                       const std::string& database = "",
+                       bool parallel = true)
         :dsp_optimizer_real<FAUSTFLOAT>(filename, argc, argv,
                                         target, buffer_size,
                                         run, opt_level,
                                         trace, control,
-                                        ds, us, filter)
+                                        ds, us, filter,
+                                        database, parallel)
         {}
     
 };
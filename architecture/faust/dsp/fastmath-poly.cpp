@@ -0,0 +1,398 @@
+/************************************************************************
+ FAUST Architecture File
+ Copyright (C) 2022 GRAME, Centre National de Creation Musicale
+ ---------------------------------------------------------------------
+ This Architecture section is free software; you can redistribute it
+ and/or modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 3 of
+ the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; If not, see <http://www.gnu.org/licenses/>.
+
+ EXCEPTION : As a special exception, you may create a larger work
+ that contains this FAUST architecture section and distribute
+ that work under terms of your choice, so long as this FAUST
+ architecture section is not modified.
+
+ Polynomial coefficients taken from the Cephes Math Library
+ (float versions, Copyright 1984-1992 Stephen L. Moshier) and from
+ FDLIBM (double versions, Copyright (C) 1993 by Sun Microsystems, Inc.
+ Developed at SunSoft, a Sun Microsystems, Inc. business.
+ Permission to use, copy, modify, and distribute this
+ software is freely granted, provided that this notice
+ is preserved).
+ ************************************************************************/
+
+/*
+ Vectorizable versions of the '-fm' mathematical functions, used with '-fm poly'.
+
+ Unlike 'fastmath.cpp', exp/exp2/exp10/log/log2/log10/pow/sin/cos/tan do not use
+ lookup tables nor branches: after inlining, the C/C++ compiler (or LLVM when this file
+ is compiled as a bitcode module and given with '-l') can vectorize the loops calling them.
+
+ Maximum errors in ULP, measured on 2 millions random values against the exact result
+ (so 0.5 is the best possible), in strict IEEE mode and with '-ffast-math':
+
+    function     float     float        double    domain
+                           fast-math
+    exp          1         1.3          1         results are saturated (no infinity nor denormal)
+    exp2         1         1.3          1.1       idem
+    exp10        1         1.3          1.4       idem
+    log          0.8       0.8          1.3       x > 0 (x <= min normal gives log(min normal))
+    log2         1.4       1.4          1.4       idem
+    log10        1.4       1.4          1.6       idem
+    pow          0.5       0.5          see (1)   x > 0
+    sin/cos      1.6       4.7          2.4       |x| < 8192 (float), |x| < 1e6 (double)
+    tan          3.2       8.4          3.6       idem
+
+ The float versions do their argument reduction in double, so that '-ffast-math' reassociation
+ cannot break it. The double versions use a Cody-Waite reduction (a constant split in several parts),
+ that '-ffast-math' compilation folds back in a single constant: exp/exp10 relative error then grows
+ up to about |x| * 1e-16 and sin/cos/tan absolute error up to about |x| * 1e-16.
+
+ (1) computed as exp(y * log(x)), so the error grows with the result exponent,
+     up to about 1 + 1.6 * |y * log(x)| ULP.
+
+ The other functions directly use the standard ones, since compilers already vectorize them
+ (fabs, sqrt, floor, ceil, rint, round...) or since there is no faster version here.
+ NaN and infinity inputs are not handled.
+*/
+
+#ifndef __faust_fastmath_poly__
+#define __faust_fastmath_poly__
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+#include <cmath>
+#else
+#include <math.h>
+#endif
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport) __attribute__((always_inline))
+#else
+#define EXPORT __attribute__ ((visibility("default"))) __attribute__((always_inline))
+#endif
+
+// Bits conversions (memcpy is compiled as a simple move)
+
+static inline float poly_asfloat(int32_t i) { float f; memcpy(&f, &i, sizeof(f)); return f; }
+static inline int32_t poly_asint(float f) { int32_t i; memcpy(&i, &f, sizeof(i)); return i; }
+static inline double poly_asdouble(int64_t i) { double d; memcpy(&d, &i, sizeof(d)); return d; }
+static inline int64_t poly_asint64(double d) { int64_t i; memcpy(&i, &d, sizeof(i)); return i; }
+
+// Round to nearest integer, with a conversion that SSE2/NEON can vectorize
+static inline int32_t poly_roundf(float x) { return (int32_t)(x + ((x < 0.f) ? -0.5f : 0.5f)); }
+static inline int32_t poly_round(double x) { return (int32_t)(x + ((x < 0.) ? -0.5 : 0.5)); }
+
+static inline float poly_clampf(float x, float lo, float hi) { return (x < lo) ? lo : ((x > hi) ? hi : x); }
+static inline double poly_clamp(double x, double lo, double hi) { return (x < lo) ? lo : ((x > hi) ? hi : x); }
+
+// ----------------------
+// float kernels (Cephes)
+// ----------------------
+
+// e^r for |r| <= ln(2)/2, scaled by 2^n with n in [-126, 127]
+static inline float poly_expf_kernel(float r, int32_t n)
+{
+    float z = r * r;
+    float p = ((((1.9875691500E-4f * r + 1.3981999507E-3f) * r + 8.3334519073E-3f) * r + 4.1665795894E-2f) * r
+               + 1.6666665459E-1f) * r + 5.0000001201E-1f;
+    return (p * z + r + 1.0f) * poly_asfloat((n + 127) << 23);
+}
+
+// log(m) with m in [sqrt(2)/2, sqrt(2)), and e so that x = m * 2^e
+static inline float poly_logf_kernel(float x, float* e)
+{
+    int32_t ix = poly_asint((x < 1.17549435E-38f) ? 1.17549435E-38f : x);
+    int32_t ex = ((ix >> 23) & 0xff) - 126;
+    float m = poly_asfloat((ix & 0x007fffff) | 0x3f000000);
+    int32_t small = (m < 0.707106781186547524f);
+    ex -= small;
+    m = (small ? (m + m) : m) - 1.0f;
+    float z = m * m;
+    float y = ((((((((7.0376836292E-2f * m - 1.1514610310E-1f) * m + 1.1676998740E-1f) * m - 1.2420140846E-1f) * m
+                   + 1.4249322787E-1f) * m - 1.6668057665E-1f) * m + 2.0000714765E-1f) * m - 2.4999993993E-1f) * m
+              + 3.3333331174E-1f) * m * z;
+    *e = (float)ex;
+    return m + (y - 0.5f * z);
+}
+
+// Reduce x to r in [-pi/4, pi/4], with x = r + k * pi/2 (done in double, see above)
+static inline float poly_reducef(float x, int32_t* k)
+{
+    double xd = (double)x;
+    *k = poly_round(xd * 6.36619772367581382433e-01);
+    double fk = (double)*k;
+    return (float)((xd - fk * 1.57079632673412561417e+00) - fk * 6.07710050630396597660e-11);
+}
+
+static inline float poly_sinf_kernel(float r, float z)
+{
+    return ((-1.9515295891E-4f * z + 8.3321608736E-3f) * z - 1.6666654611E-1f) * z * r + r;
+}
+
+static inline float poly_cosf_kernel(float z)
+{
+    return ((2.443315711809948E-5f * z - 1.388731625493765E-3f) * z + 4.166664568298827E-2f) * z * z - 0.5f * z + 1.0f;
+}
+
+// ----------------------
+// double kernels (FDLIBM)
+// ----------------------
+
+// e^(hi - lo) for |hi - lo| <= ln(2)/2, scaled by 2^n with n in [-1022, 1023]
+static inline double poly_exp_kernel(double hi, double lo, int32_t n)
+{
+    double r = hi - lo;
+    double t = r * r;
+    double c = r - t * (1.66666666666666019037e-01 + t * (-2.77777777770155933842e-03 + t * (6.61375632143793436117e-05
+                   + t * (-1.65339022054652515390e-06 + t * 4.13813679705723846039e-08))));
+    double y = 1.0 - ((lo - (r * c) / (2.0 - c)) - hi);
+    return y * poly_asdouble((int64_t)(n + 1023) << 52);
+}
+
+// log(m) with m in [sqrt(2)/2, sqrt(2)), and e so that x = m * 2^e
+static inline double poly_log_kernel(double x, double* e)
+{
+    int64_t ix = poly_asint64((x < 2.2250738585072014E-308) ? 2.2250738585072014E-308 : x);
+    int64_t ex = ((ix >> 52) & 0x7ff) - 1023;
+    double m = poly_asdouble((ix & 0x000fffffffffffffLL) | 0x3ff0000000000000LL);
+    int64_t big = (m > 1.41421356237309504880);
+    ex += big;
+    double f = (big ? (m * 0.5) : m) - 1.0;
+    double s = f / (2.0 + f);
+    double z = s * s;
+    double w = z * z;
+    double t1 = w * (3.999999999940941908e-01 + w * (2.222219843214978396e-01 + w * 1.531383769920937332e-01));
+    double t2 = z * (6.666666666666735130e-01 + w * (2.857142874366239149e-01 + w * (1.818357216161805012e-01
+                    + w * 1.479819860511658591e-01)));
+    double hfsq = 0.5 * f * f;
+    *e = (double)ex;
+    return f - (hfsq - s * (hfsq + t1 + t2));
+}
+
+// Reduce x to r in [-pi/4, pi/4], with x = r + k * pi/2
+static inline double poly_reduce(double x, int32_t* k)
+{
+    *k = poly_round(x * 6.36619772367581382433e-01);
+    double fk = (double)*k;
+    return ((x - fk * 1.57079632673412561417e+00) - fk * 6.07710050630396597660e-11) - fk * 2.02226624871116645580e-21;
+}
+
+static inline double poly_sin_kernel(double r, double z)
+{
+    double v = z * r;
+    double p = 8.33333333332248946124e-03 + z * (-1.98412698298579493134e-04 + z * (2.75573137070700676789e-06
+               + z * (-2.50507602534068634195e-08 + z * 1.58969099521155010221e-10)));
+    return r + v * (-1.66666666666666324348e-01 + z * p);
+}
+
+static inline double poly_cos_kernel(double z)
+{
+    double p = z * (4.16666666666666019037e-02 + z * (-1.38888888888741095749e-03 + z * (2.48015872894767294178e-05
+               + z * (-2.75573143513906633035e-07 + z * (2.08757232129817482790e-09 + z * -1.13596475577881948265e-11)))));
+    double hz = 0.5 * z;
+    double w = 1.0 - hz;
+    return w + (((1.0 - w) - hz) + z * p);
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    // float version
+    EXPORT float fast_fabsf(float x) { return fabsf(x); }
+    EXPORT float fast_acosf(float x) { return acosf(x); }
+    EXPORT float fast_asinf(float x) { return asinf(x); }
+    EXPORT float fast_atanf(float x) { return atanf(x); }
+    EXPORT float fast_atan2f(float x, float y) { return atan2f(x, y); }
+    EXPORT float fast_ceilf(float x) { return ceilf(x); }
+    EXPORT float fast_floorf(float x) { return floorf(x); }
+    EXPORT float fast_fmodf(float x, float y) { return fmodf(x, y); }
+    EXPORT float fast_remainderf(float x, float y) { return remainderf(x, y); }
+    EXPORT float fast_rintf(float x) { return rintf(x); }
+    EXPORT float fast_roundf(float x) { return roundf(x); }
+    EXPORT float fast_sqrtf(float x) { return sqrtf(x); }
+
+    EXPORT float fast_expf(float x)
+    {
+        double t = (double)poly_clampf(x, -87.0f, 88.0f) * 1.44269504088896338700e+00;
+        int32_t n = poly_round(t);
+        return poly_expf_kernel((float)((t - (double)n) * 6.93147180559945286227e-01), n);
+    }
+
+    EXPORT float fast_exp2f(float x)
+    {
+        x = poly_clampf(x, -126.0f, 127.0f);
+        int32_t n = poly_roundf(x);
+        return poly_expf_kernel((x - (float)n) * 0.693147180559945309f, n);
+    }
+
+    EXPORT float fast_exp10f(float x)
+    {
+        double t = (double)poly_clampf(x, -37.7f, 38.2f) * 3.32192809488736218171e+00;
+        int32_t n = poly_round(t);
+        return poly_expf_kernel((float)((t - (double)n) * 6.93147180559945286227e-01), n);
+    }
+
+    EXPORT float fast_logf(float x)
+    {
+        float e;
+        float y = poly_logf_kernel(x, &e);
+        return (float)((double)e * 6.93147180559945286227e-01 + (double)y);
+    }
+
+    EXPORT float fast_log2f(float x)
+    {
+        float e;
+        float y = poly_logf_kernel(x, &e);
+        return (float)((double)y * 1.44269504088896338700e+00 + (double)e);
+    }
+
+    EXPORT float fast_log10f(float x)
+    {
+        float e;
+        float y = poly_logf_kernel(x, &e);
+        return (float)((double)e * 3.01029995663981198017e-01 + (double)y * 4.34294481903251816668e-01);
+    }
+
+    EXPORT float fast_sinf(float x)
+    {
+        int32_t k;
+        float r = poly_reducef(x, &k);
+        float z = r * r;
+        float y = (k & 1) ? poly_cosf_kernel(z) : poly_sinf_kernel(r, z);
+        return (k & 2) ? -y : y;
+    }
+
+    EXPORT float fast_cosf(float x)
+    {
+        int32_t k;
+        float r = poly_reducef(x, &k);
+        float z = r * r;
+        float y = (k & 1) ? poly_sinf_kernel(r, z) : poly_cosf_kernel(z);
+        return ((k + 1) & 2) ? -y : y;
+    }
+
+    EXPORT float fast_tanf(float x)
+    {
+        int32_t k;
+        float r = poly_reducef(x, &k);
+        float z = r * r;
+        float s = poly_sinf_kernel(r, z);
+        float c = poly_cosf_kernel(z);
+        return (k & 1) ? (-c / s) : (s / c);
+    }
+
+    // double version
+    EXPORT double fast_fabs(double x) { return fabs(x); }
+    EXPORT double fast_acos(double x) { return acos(x); }
+    EXPORT double fast_asin(double x) { return asin(x); }
+    EXPORT double fast_atan(double x) { return atan(x); }
+    EXPORT double fast_atan2(double x, double y) { return atan2(x, y); }
+    EXPORT double fast_ceil(double x) { return ceil(x); }
+    EXPORT double fast_floor(double x) { return floor(x); }
+    EXPORT double fast_fmod(double x, double y) { return fmod(x, y); }
+    EXPORT double fast_remainder(double x, double y) { return remainder(x, y); }
+    EXPORT double fast_rint(double x) { return rint(x); }
+    EXPORT double fast_round(double x) { return round(x); }
+    EXPORT double fast_sqrt(double x) { return sqrt(x); }
+
+    EXPORT double fast_exp(double x)
+    {
+        x = poly_clamp(x, -708.0, 709.0);
+        int32_t n = poly_round(x * 1.44269504088896338700e+00);
+        double fn = (double)n;
+        return poly_exp_kernel(x - fn * 6.93147180369123816490e-01, fn * 1.90821492927058770002e-10, n);
+    }
+
+    EXPORT double fast_exp2(double x)
+    {
+        x = poly_clamp(x, -1022.0, 1023.0);
+        int32_t n = poly_round(x);
+        return poly_exp_kernel((x - (double)n) * 6.93147180559945286227e-01, 0.0, n);
+    }
+
+    EXPORT double fast_exp10(double x)
+    {
+        x = poly_clamp(x, -307.0, 308.0);
+        int32_t n = poly_round(x * 3.32192809488736218171e+00);
+        double fn = (double)n;
+        double r = (x - fn * 3.01029995663611771306e-01) - fn * 3.69423907715893078616e-13;
+        return poly_exp_kernel(r * 2.30258509299404590109e+00, 0.0, n);
+    }
+
+    EXPORT double fast_log(double x)
+    {
+        double e;
+        double y = poly_log_kernel(x, &e);
+        return e * 6.93147180369123816490e-01 + (y + e * 1.90821492927058770002e-10);
+    }
+
+    EXPORT double fast_log2(double x)
+    {
+        double e;
+        double y = poly_log_kernel(x, &e);
+        return y * 1.44269504088896338700e+00 + e;
+    }
+
+    EXPORT double fast_log10(double x)
+    {
+        double e;
+        double y = poly_log_kernel(x, &e);
+        return e * 3.01029995663611771306e-01 + (y * 4.34294481903251816668e-01 + e * 3.69423907715893078616e-13);
+    }
+
+    EXPORT double fast_pow(double x, double y)
+    {
+        return fast_exp(y * fast_log(x));
+    }
+
+    // Computed in double to keep the float result accurate
+    EXPORT float fast_powf(float x, float y)
+    {
+        return (float)fast_exp((double)y * fast_log((double)x));
+    }
+
+    EXPORT double fast_sin(double x)
+    {
+        int32_t k;
+        double r = poly_reduce(x, &k);
+        double z = r * r;
+        double y = (k & 1) ? poly_cos_kernel(z) : poly_sin_kernel(r, z);
+        return (k & 2) ? -y : y;
+    }
+
+    EXPORT double fast_cos(double x)
+    {
+        int32_t k;
+        double r = poly_reduce(x, &k);
+        double z = r * r;
+        double y = (k & 1) ? poly_sin_kernel(r, z) : poly_cos_kernel(z);
+        return ((k + 1) & 2) ? -y : y;
+    }
+
+    EXPORT double fast_tan(double x)
+    {
+        int32_t k;
+        double r = poly_reduce(x, &k);
+        double z = r * r;
+        double s = poly_sin_kernel(r, z);
+        double c = poly_cos_kernel(z);
+        return (k & 1) ? (-c / s) : (s / c);
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -23,6 +23,9 @@
  Code taken and adapted from the OWL project: https://hoxtonowl.com
  ************************************************************************/
 
+#ifndef __faust_fastmath__
+#define __faust_fastmath__
+
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -299,3 +302,5 @@ static void fast_log_set_table(const float* table, int size)
     log_table = table;
     log_precision = log2i(size);
 }
+
+#endif
@@ -480,6 +480,19 @@ LIBFAUST_API bool writeDSPFactoryToMachineFile(llvm_dsp_factory* factory, const
  */
 LIBFAUST_API bool writeDSPFactoryToObjectcodeFile(llvm_dsp_factory* factory, const std::string& object_code_path, const std::string& target);
 
+/**
+ * Write a Faust DSP factory into a position independent object code file, to be linked in a shared library.
+ *
+ * @param factory - the DSP factory
+ * @param object_code_path - the object code file pathname
+ * @param target - the LLVM machine target: like 'i386-apple-macosx10.6.0:opteron',
+ *                 using an empty string takes the current machine settings,
+ *                 and i386-apple-macosx10.6.0:generic kind of syntax for a generic processor
+ *
+ * @return true on success, false on failure.
+ */
+LIBFAUST_API bool writeDSPFactoryToPICObjectcodeFile(llvm_dsp_factory* factory, const std::string& object_code_path, const std::string& target);
+
 /**
  * Call global declarations with the given meta object.
  * 
@@ -27,6 +27,7 @@ architecture section is not modified.
 
 #include <stdio.h>
 #include <string>
+#include <new>
 #include <cmath>
 #include <algorithm>
 #include <functional>
@@ -56,6 +57,13 @@ architecture section is not modified.
 #define VOICE_STOP_LEVEL  0.0005    // -70 db
 #define MIX_BUFFER_SIZE   4096
 
+// Voice allocation traces, printed in the audio thread when keyOn/keyOff are called there, so only when POLY_TRACE is defined
+#ifdef POLY_TRACE
+#define poly_trace(...) fprintf(stderr, __VA_ARGS__)
+#else
+#define poly_trace(...)
+#endif
+
 /**
  * Allows to control zones in a grouped manner.
  */
@@ -329,20 +337,49 @@ struct dsp_voice_group {
     bool fVoiceControl;
     bool fGroupControl;
 
-    dsp_voice_group(uiCallback cb, void* arg, bool control, bool group)
+    dsp_memory_manager* fManager;        // If set, used to allocate voices and buffers
+
+    dsp_voice_group(uiCallback cb, void* arg, bool control, bool group, dsp_memory_manager* manager = nullptr)
         :fGroups(&fPanic, cb, arg),
         fVoiceGroup(0), fPanic(FAUSTFLOAT(0)),
-        fVoiceControl(control), fGroupControl(group)
+        fVoiceControl(control), fGroupControl(group),
+        fManager(manager)
     {}
 
     virtual ~dsp_voice_group()
     {
         for (size_t i = 0; i < fVoiceTable.size(); i++) {
-            delete fVoiceTable[i];
+            if (fManager) {
+                fVoiceTable[i]->~dsp_voice();
+                fManager->destroy(fVoiceTable[i]);
+            } else {
+                delete fVoiceTable[i];
+            }
         }
         delete fVoiceGroup;
     }
 
+    template <typename T>
+    T* allocate(int size)
+    {
+        return (fManager) ? static_cast<T*>(fManager->allocate(sizeof(T) * size)) : new T[size];
+    }
+
+    template <typename T>
+    void destroy(T* ptr)
+    {
+        if (fManager) {
+            fManager->destroy(ptr);
+        } else {
+            delete[] ptr;
+        }
+    }
+
+    dsp_voice* createVoice(dsp* dsp)
+    {
+        return (fManager) ? new (fManager->allocate(sizeof(dsp_voice))) dsp_voice(dsp) : new dsp_voice(dsp);
+    }
+
     void addVoice(dsp_voice* voice)
     {
         fVoiceTable.push_back(voice);
@@ -641,16 +678,16 @@ class mydsp_poly : public dsp_voice_group, public dsp_poly {
         
             // Then decide which one to steal
             if (oldest_date_release != INT_MAX) {
-                fprintf(stderr, "Steal release voice : voice_date = %d cur_date = %d voice = %d \n",
-                        fVoiceTable[voice_release]->fDate,
-                        fDate,
-                        voice_release);
+                poly_trace("Steal release voice : voice_date = %d cur_date = %d voice = %d \n",
+                           fVoiceTable[voice_release]->fDate,
+                           fDate,
+                           voice_release);
                 return allocVoice(voice_release, kLegatoVoice);
             } else if (oldest_date_playing != INT_MAX) {
-                fprintf(stderr, "Steal playing voice : voice_date = %d cur_date = %d voice = %d \n",
-                        fVoiceTable[voice_playing]->fDate,
-                        fDate,
-                        voice_release);
+                poly_trace("Steal playing voice : voice_date = %d cur_date = %d voice = %d \n",
+                           fVoiceTable[voice_playing]->fDate,
+                           fDate,
+                           voice_playing);
                 return allocVoice(voice_playing, kLegatoVoice);
             } else {
                 assert(false);
@@ -687,13 +724,16 @@ class mydsp_poly : public dsp_voice_group, public dsp_poly {
          * @param group - if true, voices are not individually accessible, a global "Voices" tab will automatically dispatch
          *                a given control on all voices, assuming GUI::updateAllGuis() is called.
          *                If false, all voices can be individually controlled.
+         * @param manager - if not null, the memory manager used to allocate the voices and the mixing buffers.
+         *                The voices DSP are cloned from 'dsp', so the factory the voice DSP comes from should also use it.
          *
          */
         mydsp_poly(dsp* dsp,
                    int nvoices,
                    bool control = false,
-                   bool group = true)
-        : dsp_voice_group(panic, this, control, group), dsp_poly(dsp) // dsp parameter is deallocated by ~dsp_poly
+                   bool group = true,
+                   dsp_memory_manager* manager = nullptr)
+        : dsp_voice_group(panic, this, control, group, manager), dsp_poly(dsp) // dsp parameter is deallocated by ~dsp_poly
         {
             fDate = 0;
             fMidiHandler = nullptr;
@@ -701,15 +741,15 @@ class mydsp_poly : public dsp_voice_group, public dsp_poly {
             // Create voices
             assert(nvoices > 0);
             for (int i = 0; i < nvoices; i++) {
-                addVoice(new dsp_voice(dsp->clone()));
+                addVoice(createVoice(dsp->clone()));
             }
 
             // Init audio output buffers
-            fMixBuffer = new FAUSTFLOAT*[getNumOutputs()];
-            fOutBuffer = new FAUSTFLOAT*[getNumOutputs()];
+            fMixBuffer = allocate<FAUSTFLOAT*>(getNumOutputs());
+            fOutBuffer = allocate<FAUSTFLOAT*>(getNumOutputs());
             for (int chan = 0; chan < getNumOutputs(); chan++) {
-                fMixBuffer[chan] = new FAUSTFLOAT[MIX_BUFFER_SIZE];
-                fOutBuffer[chan] = new FAUSTFLOAT[MIX_BUFFER_SIZE];
+                fMixBuffer[chan] = allocate<FAUSTFLOAT>(MIX_BUFFER_SIZE);
+                fOutBuffer[chan] = allocate<FAUSTFLOAT>(MIX_BUFFER_SIZE);
             }
 
             dsp_voice_group::init();
@@ -720,11 +760,11 @@ class mydsp_poly : public dsp_voice_group, public dsp_poly {
             // Remove from fMidiHandler
             if (fMidiHandler) fMidiHandler->removeMidiIn(this);
             for (int chan = 0; chan < getNumOutputs(); chan++) {
-                delete[] fMixBuffer[chan];
-                delete[] fOutBuffer[chan];
+                destroy(fMixBuffer[chan]);
+                destroy(fOutBuffer[chan]);
             }
-            delete[] fMixBuffer;
-            delete[] fOutBuffer;
+            destroy(fMixBuffer);
+            destroy(fOutBuffer);
             
         }
 
@@ -792,7 +832,7 @@ class mydsp_poly : public dsp_voice_group, public dsp_poly {
 
         virtual mydsp_poly* clone()
         {
-            return new mydsp_poly(fDSP->clone(), int(fVoiceTable.size()), fVoiceControl, fGroupControl);
+            return new mydsp_poly(fDSP->clone(), int(fVoiceTable.size()), fVoiceControl, fGroupControl, fManager);
         }
 
         void compute(int count, FAUSTFLOAT** inputs, FAUSTFLOAT** outputs)
@@ -866,7 +906,7 @@ class mydsp_poly : public dsp_voice_group, public dsp_poly {
                 voice->keyOff();
                 voice->reset();
             } else {
-                fprintf(stderr, "Voice not found\n");
+                poly_trace("Voice not found\n");
             }
         }
 
@@ -889,7 +929,7 @@ class mydsp_poly : public dsp_voice_group, public dsp_poly {
                 if (voice != kNoVoice) {
                     fVoiceTable[voice]->keyOff();
                 } else {
-                    fprintf(stderr, "Playing pitch = %d not found\n", pitch);
+                    poly_trace("Playing pitch = %d not found\n", pitch);
                 }
             }
         }
@@ -1033,7 +1073,7 @@ struct dsp_poly_factory : public dsp_factory {
      */
     dsp_poly* createPolyDSPInstance(int nvoices, bool control, bool group, bool is_double = false)
     {
-        dsp_poly* dsp_poly = new mydsp_poly(adaptDSP(fProcessFactory->createDSPInstance(), is_double), nvoices, control, group);
+        dsp_poly* dsp_poly = new mydsp_poly(adaptDSP(fProcessFactory->createDSPInstance(), is_double), nvoices, control, group, getMemoryManager());
         if (fEffectFactory) {
             // the 'dsp_poly' object has to be controlled with MIDI, so kept separated from new dsp_sequencer(...) object
             return new dsp_poly_effect(dsp_poly, new dsp_sequencer(dsp_poly, adaptDSP(fEffectFactory->createDSPInstance(), is_double)));
@@ -0,0 +1,345 @@
+/************************** BEGIN shared-library-dsp.h *********************
+FAUST Architecture File
+Copyright (C) 2003-2022 GRAME, Centre National de Creation Musicale
+---------------------------------------------------------------------
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+EXCEPTION : As a special exception, you may create a larger work
+that contains this FAUST architecture section and distribute
+that work under terms of your choice, so long as this FAUST
+architecture section is not modified.
+***************************************************************************/
+
+#ifndef __shared_library_dsp__
+#define __shared_library_dsp__
+
+#include <dlfcn.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <map>
+
+#if defined(SOUNDFILE)
+#include "faust/gui/SoundUI.h"
+#endif
+
+#include "faust/dsp/dsp.h"
+#include "faust/gui/JSONUIDecoder.h"
+
+/*
+ Loads a DSP compiled ahead-of-time as a shared library (see 'dynamic-faust -o foo.so'), without LLVM in the process.
+ The library exports the C API of the LLVM module (like in llvm-dsp-adapter.h), suffixed with the DSP class name:
+
+    void allocatemydsp(char* dsp);
+    void destroymydsp(char* dsp);
+    void instanceConstantsmydsp(char* dsp, int sample_rate);
+    void instanceClearmydsp(char* dsp);
+    void classInitmydsp(int sample_rate);
+    void computemydsp(char* dsp, int count, FAUSTFLOAT** inputs, FAUSTFLOAT** outputs);
+    char* getJSONmydsp();
+    const char* getSHAKeymydsp();
+
+ The user interface is built from the JSON description, and the DSP state is a memory block of 'size' bytes.
+ Factories are kept in a cache indexed by the SHA key of their DSP code: loading a library with an already
+ loaded SHA key returns the same (reference counted) factory.
+ */
+
+class shared_library_dsp_factory;
+
+inline shared_library_dsp_factory* readDSPFactoryFromSharedLibrary(const std::string& library_path,
+                                                                   std::string& error_msg,
+                                                                   const std::string& class_name = "mydsp");
+inline shared_library_dsp_factory* getSharedLibraryDSPFactoryFromSHAKey(const std::string& sha_key);
+inline bool deleteSharedLibraryDSPFactory(shared_library_dsp_factory* factory);
+
+class shared_library_dsp : public dsp {
+
+    private:
+
+        shared_library_dsp_factory* fFactory;
+        JSONUIDecoderBase* fDecoder;
+        char* fDSP;
+
+    public:
+
+        shared_library_dsp(shared_library_dsp_factory* factory, JSONUIDecoderBase* decoder, char* dsp_block);
+
+        virtual ~shared_library_dsp();
+
+        virtual int getNumInputs() { return fDecoder->getNumInputs(); }
+
+        virtual int getNumOutputs() { return fDecoder->getNumOutputs(); }
+
+        virtual void buildUserInterface(UI* ui_interface) { fDecoder->buildUserInterface(ui_interface, fDSP); }
+
+        virtual int getSampleRate() { return fDecoder->getSampleRate(fDSP); }
+
+        virtual void init(int sample_rate)
+        {
+            classInit(sample_rate);
+            instanceInit(sample_rate);
+        }
+
+        virtual void instanceInit(int sample_rate)
+        {
+            instanceConstants(sample_rate);
+            instanceResetUserInterface();
+            instanceClear();
+        }
+
+        virtual void instanceConstants(int sample_rate);
+
+        virtual void instanceResetUserInterface()
+        {
+        #if defined(SOUNDFILE)
+            fDecoder->resetUserInterface(fDSP, defaultsound);
+        #else
+            fDecoder->resetUserInterface(fDSP, nullptr);
+        #endif
+        }
+
+        virtual void instanceClear();
+
+        void classInit(int sample_rate);
+
+        virtual shared_library_dsp* clone();
+
+        virtual void metadata(Meta* m) { fDecoder->metadata(m); }
+
+        virtual void compute(int count, FAUSTFLOAT** inputs, FAUSTFLOAT** outputs);
+
+        virtual void compute(double /*date_usec*/, int count, FAUSTFLOAT** inputs, FAUSTFLOAT** outputs)
+        {
+            compute(count, inputs, outputs);
+        }
+
+};
+
+class shared_library_dsp_factory : public dsp_factory {
+
+    friend class shared_library_dsp;
+    friend shared_library_dsp_factory* readDSPFactoryFromSharedLibrary(const std::string& library_path,
+                                                                       std::string& error_msg,
+                                                                       const std::string& class_name);
+    friend shared_library_dsp_factory* getSharedLibraryDSPFactoryFromSHAKey(const std::string& sha_key);
+    friend bool deleteSharedLibraryDSPFactory(shared_library_dsp_factory* factory);
+
+    private:
+
+        typedef void (*allocateFun)(char* dsp);
+        typedef void (*destroyFun)(char* dsp);
+        typedef void (*instanceConstantsFun)(char* dsp, int sample_rate);
+        typedef void (*instanceClearFun)(char* dsp);
+        typedef void (*classInitFun)(int sample_rate);
+        typedef void (*computeFun)(char* dsp, int count, FAUSTFLOAT** inputs, FAUSTFLOAT** outputs);
+        typedef char* (*getJSONFun)();
+        typedef const char* (*getSHAKeyFun)();
+
+        void* fHandle;
+        std::string fJSON;
+        std::string fSHAKey;
+        int fReferences;
+        JSONUIDecoderBase* fDecoder;
+        dsp_memory_manager* fManager;
+
+        allocateFun fAllocate;
+        destroyFun fDestroy;
+        instanceConstantsFun fInstanceConstants;
+        instanceClearFun fInstanceClear;
+        classInitFun fClassInit;
+        computeFun fCompute;
+
+        static std::map<std::string, shared_library_dsp_factory*>& getFactoryTable()
+        {
+            static std::map<std::string, shared_library_dsp_factory*> gFactoryTable;
+            return gFactoryTable;
+        }
+
+        template <typename FUN>
+        bool getFunction(FUN& fun, const std::string& name, const std::string& class_name, std::string& error_msg)
+        {
+            fun = reinterpret_cast<FUN>(dlsym(fHandle, (name + class_name).c_str()));
+            if (!fun) error_msg = "ERROR : missing '" + name + class_name + "' function in shared library\n";
+            return fun != nullptr;
+        }
+
+        shared_library_dsp_factory(void* handle)
+        :fHandle(handle), fReferences(1), fDecoder(nullptr), fManager(nullptr)
+        {}
+
+        bool init(const std::string& library_path, const std::string& class_name, std::string& error_msg)
+        {
+            getJSONFun getJSON;
+            getSHAKeyFun getSHAKey;
+            if (!getFunction(fAllocate, "allocate", class_name, error_msg)
+                || !getFunction(fDestroy, "destroy", class_name, error_msg)
+                || !getFunction(fInstanceConstants, "instanceConstants", class_name, error_msg)
+                || !getFunction(fInstanceClear, "instanceClear", class_name, error_msg)
+                || !getFunction(fClassInit, "classInit", class_name, error_msg)
+                || !getFunction(fCompute, "compute", class_name, error_msg)
+                || !getFunction(getJSON, "getJSON", class_name, error_msg)) {
+                return false;
+            }
+            fJSON = getJSON();
+            fDecoder = createJSONUIDecoder(fJSON);
+            if (fDecoder->hasCompileOption("-double") != (sizeof(FAUSTFLOAT) == sizeof(double))) {
+                error_msg = "ERROR : FAUSTFLOAT type does not match the shared library sample type\n";
+                return false;
+            }
+            // Libraries without SHA key are indexed by their path
+            fSHAKey = (getFunction(getSHAKey, "getSHAKey", class_name, error_msg)) ? getSHAKey() : library_path;
+            error_msg = "";
+            return true;
+        }
+
+        virtual ~shared_library_dsp_factory()
+        {
+            delete fDecoder;
+            dlclose(fHandle);
+        }
+
+    public:
+
+        std::string getName() { return fDecoder->getName(); }
+        std::string getSHAKey() { return fSHAKey; }
+        std::string getDSPCode() { return ""; }
+        std::string getCompileOptions() { return fDecoder->getCompileOptions(); }
+        std::vector<std::string> getLibraryList() { return fDecoder->getLibraryList(); }
+        std::vector<std::string> getIncludePathnames() { return fDecoder->getIncludePathnames(); }
+
+        shared_library_dsp* createDSPInstance()
+        {
+            size_t size = fDecoder->getDSPSize();
+            char* dsp_block = static_cast<char*>((fManager) ? fManager->allocate(size) : calloc(1, size));
+            if (fManager) memset(dsp_block, 0, size);
+            fAllocate(dsp_block);
+            fReferences++;
+            // Each instance uses its own decoder, since controls are described with offsets in its memory block
+            return new shared_library_dsp(this, createJSONUIDecoder(fJSON), dsp_block);
+        }
+
+        void setMemoryManager(dsp_memory_manager* manager) { fManager = manager; }
+        dsp_memory_manager* getMemoryManager() { return fManager; }
+
+};
+
+inline shared_library_dsp::shared_library_dsp(shared_library_dsp_factory* factory, JSONUIDecoderBase* decoder, char* dsp_block)
+    :fFactory(factory), fDecoder(decoder), fDSP(dsp_block)
+{}
+
+inline shared_library_dsp::~shared_library_dsp()
+{
+    fFactory->fDestroy(fDSP);
+    if (fFactory->fManager) {
+        fFactory->fManager->destroy(fDSP);
+    } else {
+        free(fDSP);
+    }
+    delete fDecoder;
+    deleteSharedLibraryDSPFactory(fFactory);
+}
+
+inline void shared_library_dsp::instanceConstants(int sample_rate) { fFactory->fInstanceConstants(fDSP, sample_rate); }
+
+inline void shared_library_dsp::instanceClear() { fFactory->fInstanceClear(fDSP); }
+
+inline void shared_library_dsp::classInit(int sample_rate) { fFactory->fClassInit(sample_rate); }
+
+inline shared_library_dsp* shared_library_dsp::clone() { return fFactory->createDSPInstance(); }
+
+inline void shared_library_dsp::compute(int count, FAUSTFLOAT** inputs, FAUSTFLOAT** outputs)
+{
+    fFactory->fCompute(fDSP, count, inputs, outputs);
+}
+
+/**
+ * Create a Faust DSP factory from a shared library generated with 'dynamic-faust -o foo.so'.
+ * The library keeps an internal cache of all loaded factories indexed by SHA key, so that loading the same DSP
+ * returns the same (reference counted) factory pointer. You will have to explicitly use deleteSharedLibraryDSPFactory
+ * to properly decrement the reference counter when the factory is no more needed.
+ *
+ * @param library_path - the shared library pathname
+ * @param error_msg - the error string to be filled
+ * @param class_name - the DSP class name used at compilation time (see the -cn option)
+ *
+ * @return the DSP factory on success, otherwise a null pointer.
+ */
+inline shared_library_dsp_factory* readDSPFactoryFromSharedLibrary(const std::string& library_path,
+                                                                   std::string& error_msg,
+                                                                   const std::string& class_name)
+{
+    void* handle = dlopen(library_path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+        error_msg = "ERROR : " + std::string(dlerror()) + "\n";
+        return nullptr;
+    }
+    shared_library_dsp_factory* factory = new shared_library_dsp_factory(handle);
+    if (!factory->init(library_path, class_name, error_msg)) {
+        delete factory;
+        return nullptr;
+    }
+    std::map<std::string, shared_library_dsp_factory*>& table = shared_library_dsp_factory::getFactoryTable();
+    auto it = table.find(factory->getSHAKey());
+    if (it != table.end()) {
+        delete factory;
+        (*it).second->fReferences++;
+        return (*it).second;
+    } else {
+        table[factory->getSHAKey()] = factory;
+        return factory;
+    }
+}
+
+/**
+ * Get the Faust DSP factory associated with a given SHA key, if already loaded, and increment its reference counter.
+ *
+ * @param sha_key - the SHA key of an already loaded factory
+ *
+ * @return a DSP factory if one is associated with the SHA key, otherwise a null pointer.
+ */
+inline shared_library_dsp_factory* getSharedLibraryDSPFactoryFromSHAKey(const std::string& sha_key)
+{
+    std::map<std::string, shared_library_dsp_factory*>& table = shared_library_dsp_factory::getFactoryTable();
+    auto it = table.find(sha_key);
+    if (it != table.end()) {
+        (*it).second->fReferences++;
+        return (*it).second;
+    } else {
+        return nullptr;
+    }
+}
+
+/**
+ * Delete a Faust DSP factory, that is decrements its reference counter, possibly really unloading the shared library
+ * when the last factory reference and the last DSP instance are deleted.
+ *
+ * @param factory - the DSP factory
+ *
+ * @return true if the factory was really deleted, and false if only 'decremented'.
+ */
+inline bool deleteSharedLibraryDSPFactory(shared_library_dsp_factory* factory)
+{
+    if (--factory->fReferences == 0) {
+        shared_library_dsp_factory::getFactoryTable().erase(factory->getSHAKey());
+        delete factory;
+        return true;
+    } else {
+        return false;
+    }
+}
+
+#endif
+/************************** END shared-library-dsp.h **************************/
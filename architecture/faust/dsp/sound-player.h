@@ -29,6 +29,7 @@ architecture section is not modified.
 #include <string>
 #include <iostream>
 #include <mutex>
+#include <atomic>
 
 #include "faust/dsp/dsp.h"
 #include "faust/gui/ring-buffer.h"
@@ -282,12 +283,13 @@ class sound_dtd_player : public sound_base_player {
     private:
         
         ringbuffer_t* fBuffer;  // Ringbuffer written in setFrame and read in playSlice
+        std::atomic<size_t> fMissingFrames;  // Frames not yet available in the ringbuffer when playing (cleared in the output), updated in the audio thread
         
         void playSlice(int count, int src, int dst, FAUSTFLOAT** outputs)
         {
             size_t read_space_frames = convertToFrames(ringbuffer_read_space(fBuffer));
             
-            if (read_space_frames >= count) {
+            if (read_space_frames >= size_t(count)) {
                 
                 // Read from ringbuffer
                 FAUSTFLOAT buffer[count * fInfo.channels];
@@ -301,7 +303,9 @@ class sound_dtd_player : public sound_base_player {
                 }
                 
             } else {
-                std::cerr << "PlaySlice : missing " << (count - read_space_frames) << " frames\n";
+                // No output in the audio thread, see getMissingFrames
+                clearSlice(count, dst, outputs);
+                fMissingFrames.fetch_add(count - read_space_frames, std::memory_order_relaxed);
             }
         }
         
@@ -353,6 +357,7 @@ class sound_dtd_player : public sound_base_player {
         {
             // Create ringbuffer
             fBuffer = ringbuffer_create(RING_BUFFER_SIZE * fInfo.channels * sizeof(FAUSTFLOAT));
+            fMissingFrames.store(0, std::memory_order_relaxed);
             
             // Read first buffer
             setFrame(0);
@@ -366,6 +371,9 @@ class sound_dtd_player : public sound_base_player {
         
         sound_dtd_player* clone() { return new sound_dtd_player(fFileName); }
     
+        // Number of frames that were missing in the ringbuffer when playing
+        size_t getMissingFrames() { return fMissingFrames.load(std::memory_order_relaxed); }
+    
 };
 
 /**
@@ -20,11 +20,14 @@
  ************************************************************************/
 
 #include <cassert>
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <string>
+#include <vector>
 #ifndef _WIN32
-#include <sys/time.h>
+#include <sys/resource.h>
 #endif
 #include "Text.hh"
 #include "compatibility.hh"
@@ -33,59 +36,180 @@
 
 // Timing can be used outside of the scope of 'gGlobal'
 bool     gTimingSwitch;
-int      gTimingIndex;
-double   gStartTime[1024];
-double   gEndTime[1024];
-ostream* gTimingLog = 0;
+ostream* gTimingLog = nullptr;
 
-#ifndef _WIN32
-double mysecond()
+// Memory counters sampled at the beginning and end of each span
+struct TimingCounters {
+    size_t fTrees      = 0;
+    size_t fBuckets    = 0;
+    size_t fProperties = 0;
+    size_t fPeakRSS    = 0;  // in KB
+};
+
+struct TimingSpan {
+    string         fName;
+    double         fStart;  // in microseconds
+    double         fDuration;
+    TimingCounters fBegin;
+    TimingCounters fEnd;
+};
+
+static vector<TimingSpan> gTimingStack;
+static vector<TimingSpan> gTimingSpans;  // closed spans, to be written in the JSON file
+static string             gTimingJSONFile;
+static double             gSamplingTime = 0;  // time spent sampling the counters, removed from the timestamps
+
+static double mysecond()
 {
-    struct timeval  tp;
-    struct timezone tzp;
-    gettimeofday(&tp, &tzp);
-    return ((double)tp.tv_sec + (double)tp.tv_usec * 1.e-6);
+    static const chrono::steady_clock::time_point origin = chrono::steady_clock::now();
+    return chrono::duration<double>(chrono::steady_clock::now() - origin).count();
 }
 
-#else
-double mysecond()
+static size_t peakRSS()
 {
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+        return size_t(usage.ru_maxrss) / 1024;  // in bytes on macOS
+#else
+        return size_t(usage.ru_maxrss);
+#endif
+    }
+#endif
     return 0;
 }
-#endif
+
+// Timestamp excluding the time spent to sample the counters
+static double timestamp()
+{
+    return (mysecond() - gSamplingTime) * 1e6;
+}
+
+static TimingCounters sampleCounters()
+{
+    TimingCounters counters;
+    double         start = mysecond();
+    CTree::statistics(counters.fTrees, counters.fBuckets, counters.fProperties);
+    counters.fPeakRSS = peakRSS();
+    gSamplingTime += mysecond() - start;
+    return counters;
+}
+
+static void writeJSONString(ostream& out, const string& str)
+{
+    out << '"';
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (c >= 0 && c < 0x20) {
+            out << ' ';
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+static void writeCounterEvent(ostream& out, double ts, const TimingCounters& counters)
+{
+    out << ",\n{\"name\":\"CTree\",\"ph\":\"C\",\"ts\":" << ts << ",\"pid\":1,\"tid\":1,\"args\":{\"trees\":"
+        << counters.fTrees << ",\"properties\":" << counters.fProperties << "}}";
+    out << ",\n{\"name\":\"peak RSS (KB)\",\"ph\":\"C\",\"ts\":" << ts << ",\"pid\":1,\"tid\":1,\"args\":{\"value\":"
+        << counters.fPeakRSS << "}}";
+}
+
+// Write all closed spans in the Chrome trace event format (loadable in chrome://tracing or Perfetto)
+static void writeTimingJSON()
+{
+    ofstream out(gTimingJSONFile.c_str());
+    if (!out.is_open()) {
+        cerr << "WARNING : file '" << gTimingJSONFile << "' cannot be opened\n";
+        return;
+    }
+    out << fixed;
+    out.precision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"faust\"}}";
+    for (const auto& span : gTimingSpans) {
+        double load = double(span.fEnd.fTrees) / double(CTree::hashTableSize());
+        out << ",\n{\"name\":";
+        writeJSONString(out, span.fName);
+        out << ",\"cat\":\"faust\",\"ph\":\"X\",\"ts\":" << span.fStart << ",\"dur\":" << span.fDuration
+            << ",\"pid\":1,\"tid\":1,\"args\":{\"trees\":" << span.fEnd.fTrees
+            << ",\"new trees\":" << (long long)span.fEnd.fTrees - (long long)span.fBegin.fTrees
+            << ",\"hash buckets\":" << span.fEnd.fBuckets << ",\"hash load\":" << load
+            << ",\"properties\":" << span.fEnd.fProperties
+            << ",\"new properties\":" << (long long)span.fEnd.fProperties - (long long)span.fBegin.fProperties
+            << ",\"peak RSS (KB)\":" << span.fEnd.fPeakRSS << "}}";
+        writeCounterEvent(out, span.fStart, span.fBegin);
+        writeCounterEvent(out, span.fStart + span.fDuration, span.fEnd);
+    }
+    out << "\n]}\n";
+}
+
+void setTimingJSONFile(const char* file)
+{
+    gTimingJSONFile = file;
+    gTimingStack.clear();
+    gTimingSpans.clear();
+}
 
 void startTiming(const char* msg)
 {
-    // timing
-    gTimingLog = (getenv("FAUST_TIMING")) ? new ofstream("FAUST_TIMING_LOG", ios::app) : NULL;
-    if (gTimingLog) {
-        *gTimingLog << endl;
+    bool json = gTimingJSONFile != "";
+    if (!gTimingSwitch && !json) return;
+
+    // The log file is opened once
+    static bool log_init = false;
+    if (!log_init) {
+        gTimingLog = (getenv("FAUST_TIMING")) ? new ofstream("FAUST_TIMING_LOG", ios::app) : nullptr;
+        log_init   = true;
     }
 
     if (gTimingSwitch) {
-        faustassert(gTimingIndex < 1023);
         if (gTimingLog) {
-            tab(gTimingIndex, *gTimingLog);
+            *gTimingLog << endl;
+            tab(int(gTimingStack.size()), *gTimingLog);
             *gTimingLog << "start " << msg << endl;
         } else {
-            tab(gTimingIndex, cerr);
+            tab(int(gTimingStack.size()), cerr);
             cerr << "start " << msg << endl;
         }
-        gStartTime[gTimingIndex++] = mysecond();
     }
+
+    TimingSpan span;
+    span.fName = msg;
+    if (json) span.fBegin = sampleCounters();
+    span.fStart    = timestamp();
+    span.fDuration = 0;
+    gTimingStack.push_back(span);
 }
 
 void endTiming(const char* msg)
 {
+    bool json = gTimingJSONFile != "";
+    if (!gTimingSwitch && !json) return;
+
+    faustassert(gTimingStack.size() > 0);
+    TimingSpan span = gTimingStack.back();
+    gTimingStack.pop_back();
+    span.fDuration = timestamp() - span.fStart;
+
     if (gTimingSwitch) {
-        faustassert(gTimingIndex > 0);
-        gEndTime[--gTimingIndex] = mysecond();
         if (gTimingLog) {
-            *gTimingLog << msg << "\t" << gEndTime[gTimingIndex] - gStartTime[gTimingIndex] << endl;
+            *gTimingLog << msg << "\t" << span.fDuration * 1e-6 << endl;
             gTimingLog->flush();
         } else {
-            tab(gTimingIndex, cerr);
-            cerr << "end " << msg << " (duration : " << gEndTime[gTimingIndex] - gStartTime[gTimingIndex] << ")\n";
+            tab(int(gTimingStack.size()), cerr);
+            cerr << "end " << msg << " (duration : " << span.fDuration * 1e-6 << ")\n";
         }
     }
+
+    if (json) {
+        span.fEnd = sampleCounters();
+        gTimingSpans.push_back(span);
+        // Rewritten each time the outermost span is closed, so that spans done later (like the JIT compilation) are added
+        if (gTimingStack.size() == 0) writeTimingJSON();
+    }
 }
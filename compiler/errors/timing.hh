@@ -25,6 +25,10 @@
 // use startTiming("foo") and endTiming("foo") to measure the execution time of a portion of code
 // edit timing.cpp to unactivate the code
 
+// spans are displayed with -time, and written with memory counters in the Chrome trace event format
+// in 'file' with -time-json <file>
+void setTimingJSONFile(const char* file);
+
 void startTiming(const char* msg);
 void endTiming(const char* msg);
 
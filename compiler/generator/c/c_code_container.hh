@@ -83,8 +83,7 @@ class CCodeContainer : public virtual CodeContainer {
 
         // For mathematical functions
         if (gGlobal->gFastMath) {
-            addIncludeFile((gGlobal->gFastMathLib == "def") ? "\"faust/dsp/fastmath.cpp\""
-                                                            : ("\"" + gGlobal->gFastMathLib + "\""));
+            addIncludeFile("\"" + gGlobal->getFastMathFile() + "\"");
         } else {
             addIncludeFile("<math.h>");
         }
@@ -170,8 +169,7 @@ class CScalarOneSampleCodeContainer1 : public CScalarCodeContainer {
         
         // For mathematical functions
         if (gGlobal->gFastMath) {
-            addIncludeFile((gGlobal->gFastMathLib == "def") ? "\"faust/dsp/fastmath.cpp\""
-                           : ("\"" + gGlobal->gFastMathLib + "\""));
+            addIncludeFile("\"" + gGlobal->getFastMathFile() + "\"");
         } else {
             addIncludeFile("<math.h>");
         }
@@ -213,8 +211,7 @@ class CScalarOneSampleCodeContainer2 : public CScalarCodeContainer {
             
             // For mathematical functions
             if (gGlobal->gFastMath) {
-                addIncludeFile((gGlobal->gFastMathLib == "def") ? "\"faust/dsp/fastmath.cpp\""
-                               : ("\"" + gGlobal->gFastMathLib + "\""));
+                addIncludeFile("\"" + gGlobal->getFastMathFile() + "\"");
             } else {
                 addIncludeFile("<math.h>");
             }
@@ -254,8 +251,7 @@ class CScalarOneSampleCodeContainer3 : public CScalarOneSampleCodeContainer2 {
             
             // For mathematical functions
             if (gGlobal->gFastMath) {
-                addIncludeFile((gGlobal->gFastMathLib == "def") ? "\"faust/dsp/fastmath.cpp\""
-                               : ("\"" + gGlobal->gFastMathLib + "\""));
+                addIncludeFile("\"" + gGlobal->getFastMathFile() + "\"");
             } else {
                 addIncludeFile("<math.h>");
             }
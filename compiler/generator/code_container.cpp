@@ -26,6 +26,7 @@
 #include "fir_to_fir.hh"
 #include "floats.hh"
 #include "global.hh"
+#include "ppsig.hh"
 #include "recursivness.hh"
 #include "text_instructions.hh"
 #include "type_manager.hh"
@@ -164,6 +165,7 @@ void CodeContainer::closeLoop(Tree sig)
         // cout << " will NOT absorb" << endl;
         // we have an independent loop
         setLoopProperty(sig, l);  // associate the signal
+        l->fSignal = sig;
         fCurLoop->fBackwardLoopDependencies.insert(l);
         // we need to indicate that all recursive symbols defined
         // in this loop are defined in this loop
@@ -317,6 +319,15 @@ void CodeContainer::generateDAGLoopInternal(CodeLoop* loop, BlockInst* block, De
 void CodeContainer::generateDAGLoopAux(CodeLoop* loop, BlockInst* loop_code, DeclareVarInst* count, int loop_num,
                                        bool omp)
 {
+    // The same loop may be generated several times (see VectorCodeContainer::generateDAGLoopVariant0)
+    int slot = -1;
+    if (gGlobal->gProfileLoops) {
+        if (fProfileSlots.find(loop) == fProfileSlots.end()) {
+            fProfileSlots[loop] = addProfileSlot(getProfileLabel(loop, loop_num));
+        }
+        slot = fProfileSlots[loop];
+    }
+    
     if (gGlobal->gFunTaskSwitch) {
         BlockInst* block = InstBuilder::genBlockInst();
         // Generates scalar or vectorized loop
@@ -326,14 +337,18 @@ void CodeContainer::generateDAGLoopAux(CodeLoop* loop, BlockInst* loop_code, Dec
         loop_code->pushBackInst(InstBuilder::genLabelInst((loop->fIsRecursive)
                                                               ? subst("/* Recursive function $0 */", T(loop_num))
                                                               : subst("/* Vectorizable function $0 */", T(loop_num))));
+        if (slot >= 0) loop_code->pushBackInst(generateProfileStart(slot));
         loop_code->pushBackInst(builder.fFunctionCall);
     } else {
         loop_code->pushBackInst(InstBuilder::genLabelInst((loop->fIsRecursive)
                                                               ? subst("/* Recursive loop $0 */", T(loop_num))
                                                               : subst("/* Vectorizable loop $0 */", T(loop_num))));
+        if (slot >= 0) loop_code->pushBackInst(generateProfileStart(slot));
         // Generates scalar or vectorized loop
         generateDAGLoopInternal(loop, loop_code, count, omp);
     }
+    
+    if (slot >= 0) loop_code->pushBackInst(generateProfileEnd(slot));
 }
 
 void CodeContainer::generateDAGLoop(BlockInst* block, DeclareVarInst* count)
@@ -358,6 +373,80 @@ void CodeContainer::generateDAGLoop(BlockInst* block, DeclareVarInst* count)
     }
 }
 
+/*
+    With -prof, parts of 'compute' are surrounded by reads of a cycle counter ('faustProfileCycles'
+    defined by the backend), and their durations accumulated in 'iProfileCycles' fields:
+    the control code, then the sample loop in scalar mode or each loop of the DAG in vector mode.
+*/
+int CodeContainer::addProfileSlot(const string& label)
+{
+    int    slot  = int(fProfileLabels.size());
+    string field = subst("iProfileCycles$0", T(slot));
+    fProfileLabels.push_back(label);
+    pushDeclare(InstBuilder::genDecStructVar(field, InstBuilder::genInt64Typed()));
+    pushClearMethod(InstBuilder::genStoreStructVar(field, InstBuilder::genInt64NumInst(0)));
+    return slot;
+}
+
+StatementInst* CodeContainer::generateProfileStart(int slot)
+{
+    return InstBuilder::genDecStackVar(subst("iProfileStart$0", T(slot)), InstBuilder::genInt64Typed(),
+                                       InstBuilder::genFunCallInst("faustProfileCycles", Values()));
+}
+
+StatementInst* CodeContainer::generateProfileEnd(int slot)
+{
+    string     field    = subst("iProfileCycles$0", T(slot));
+    ValueInst* duration = InstBuilder::genSub(InstBuilder::genFunCallInst("faustProfileCycles", Values()),
+                                              InstBuilder::genLoadStackVar(subst("iProfileStart$0", T(slot))));
+    return InstBuilder::genStoreStructVar(field, InstBuilder::genAdd(InstBuilder::genLoadStructVar(field), duration));
+}
+
+// Keeps the beginning of the signal computed by the loop, since complete expressions can be huge
+struct LimitedStringBuf : public streambuf {
+    string fStr;
+    size_t fMaxSize;
+
+    LimitedStringBuf(size_t max_size) : fMaxSize(max_size) {}
+
+    // Fails when full, so that the stream gets badbit and ppsig stops printing
+    virtual int overflow(int c)
+    {
+        if (fStr.size() == fMaxSize) return traits_type::eof();
+        fStr += char(c);
+        return c;
+    }
+};
+
+string CodeContainer::getProfileLabel(CodeLoop* loop, int loop_num)
+{
+    string label = subst((loop->fIsRecursive) ? "recursive loop $0" : "vectorizable loop $0", T(loop_num));
+    if (loop->fSignal != gGlobal->nil) {
+        LimitedStringBuf buffer(80);
+        ostream          out(&buffer);
+        out << ppsig(loop->fSignal);
+        label += " : " + buffer.fStr + ((out.good()) ? "" : "...");
+    }
+    // To be used in a C string
+    return replaceChar(replaceChar(flatten(label), '"', '\''), '\\', '/');
+}
+
+void CodeContainer::generateProfile()
+{
+    gGlobal->setVarType("faustProfileCycles", Typed::kInt64);
+    
+    int control = addProfileSlot("control");
+    fComputeBlockInstructions->pushFrontInst(generateProfileStart(control));
+    fComputeBlockInstructions->pushBackInst(generateProfileEnd(control));
+    
+    // Vector loops are measured in generateDAGLoopAux
+    if (!gGlobal->gVectorSwitch) {
+        int loop = addProfileSlot("sample loop");
+        fComputeBlockInstructions->pushBackInst(generateProfileStart(loop));
+        fPostComputeBlockInstructions->pushFrontInst(generateProfileEnd(loop));
+    }
+}
+
 void CodeContainer::processFIR(void)
 {
     // Types used in 'compute' prototype
@@ -374,6 +463,21 @@ void CodeContainer::processFIR(void)
         set<CodeLoop*> visited;
         CodeLoop::groupSeqLoops(fCurLoop, visited);
     }
+
+    // Possibly reorder the DSP struct fields, before the backends compute their layout
+    if (gGlobal->gHotColdStruct) {
+        sortHotColdDeclarations();
+    }
+
+    // Possibly measure the parts of 'compute'
+    if (gGlobal->gProfileLoops) {
+        generateProfile();
+    }
+
+    // Cache footprint, exported in the JSON description
+    if (gGlobal->gPrintJSONSwitch) {
+        generateFootprint();
+    }
  
     /*
         Create memory layout, to be used in C++ backend and JSON generation.
@@ -494,6 +598,144 @@ void CodeContainer::processFIR(void)
      */
 }
 
+// Count the field and table accesses in all DSP loops (in scalar or vector mode)
+void CodeContainer::countLoopAccesses(StructAccessCounter& counter)
+{
+    set<CodeLoop*>  visited;
+    list<CodeLoop*> loops;
+    sortDeepFirstDAG(fCurLoop, visited, loops);
+    DeclareVarInst* count = InstBuilder::genDecStackVar("count", InstBuilder::genInt32Typed());
+    for (const auto& it : loops) {
+        BlockInst* block = InstBuilder::genBlockInst();
+        it->generateDAGScalarLoop(block, count, false);
+        block->accept(&counter);
+    }
+}
+
+/*
+    Order the DSP struct fields in three zones:
+    - 'hot' fields accessed in the DSP loops, scalars first then arrays by increasing size,
+      so that the state used for each sample is contiguous
+    - 'warm' fields only accessed once per block in the control code of 'compute'
+    - 'cold' fields (constants, zones only used by the UI...)
+    The declaration order is kept inside each zone.
+*/
+void CodeContainer::sortHotColdDeclarations()
+{
+    // Count the accesses in all DSP loops
+    StructAccessCounter loop_counter;
+    countLoopAccesses(loop_counter);
+
+    // Count the accesses in the control code
+    StructAccessCounter control_counter;
+    fComputeBlockInstructions->accept(&control_counter);
+    fPostComputeBlockInstructions->accept(&control_counter);
+
+    auto zone = [&](StatementInst* inst) {
+        DeclareVarInst* dec = dynamic_cast<DeclareVarInst*>(inst);
+        if (!dec) {
+            return 2;
+        } else if (loop_counter.getAccessCount(dec->getName()) > 0) {
+            return 0;
+        } else if (control_counter.getAccessCount(dec->getName()) > 0) {
+            return 1;
+        } else {
+            return 2;
+        }
+    };
+
+    auto size = [](StatementInst* inst) {
+        DeclareVarInst* dec = dynamic_cast<DeclareVarInst*>(inst);
+        return (dec) ? dec->fType->getSizeBytes() : 0;
+    };
+
+    vector<pair<int, StatementInst*>> fields;
+    for (const auto& it : fDeclarationInstructions->fCode) {
+        fields.push_back(make_pair(zone(it), it));
+    }
+    stable_sort(fields.begin(), fields.end(),
+                [&](const pair<int, StatementInst*>& a, const pair<int, StatementInst*>& b) {
+                    return (a.first != b.first) ? (a.first < b.first)
+                                                : ((a.first == 0) && (size(a.second) < size(b.second)));
+                });
+
+    fDeclarationInstructions->fCode.clear();
+    for (const auto& it : fields) {
+        fDeclarationInstructions->fCode.push_back(it.second);
+    }
+}
+
+/*
+    Estimate the cache footprint of the DSP:
+    - 'struct_size' : size in bytes of the DSP fields (without the virtual table pointer)
+    - 'tables_size' : size in bytes of the static tables, shared by all instances
+    - 'working_set_size' : size in bytes of the fields and tables accessed in the DSP loops
+    - 'bytes_per_sample' : bytes read or written for each sample, counting one access for each load/store
+      of a field or table in the DSP loops, and the input/output samples
+    - 'block_size_l1' and 'block_size_l2' : the biggest power-of-two block size (up to 4096 frames)
+      keeping the working set and the input/output buffers in a 32 KB L1 or a 256 KB L2 cache, 0 if none
+*/
+void CodeContainer::generateFootprint()
+{
+    // Count the accesses in all DSP loops
+    StructAccessCounter loop_counter;
+    countLoopAccesses(loop_counter);
+
+    // Tables size in bytes, by variable name (tables are declared with a null size when allocated with -mem)
+    map<string, int> tables;
+    for (const auto& it : gGlobal->gTablesSize) {
+        tables[it.second.first] = it.second.second;
+    }
+
+    int struct_size      = 0;
+    int tables_size      = 0;
+    int working_set      = 0;
+    int bytes_per_sample = 0;
+
+    auto add = [&](BlockInst* block, bool global) {
+        for (const auto& it : block->fCode) {
+            DeclareVarInst* dec = dynamic_cast<DeclareVarInst*>(it);
+            if (!dec) continue;
+            string      name        = dec->getName();
+            ArrayTyped* array_typed = dynamic_cast<ArrayTyped*>(dec->fType);
+            int         size        = dec->fType->getSizeBytes();
+            int         item_size   = (array_typed) ? gGlobal->gTypeSizeMap[array_typed->fType->getType()] : size;
+            if (global) {
+                if (tables.find(name) == tables.end()) continue;
+                size = tables[name];
+                tables_size += size;
+            } else {
+                struct_size += size;
+            }
+            int access = loop_counter.getAccessCount(name);
+            if (access > 0) {
+                working_set += size;
+                bytes_per_sample += access * item_size;
+            }
+        }
+    };
+    add(fDeclarationInstructions, false);
+    add(fGlobalDeclarationInstructions, true);
+
+    int io_size = (fNumInputs + fNumOutputs) * gGlobal->gTypeSizeMap[Typed::kFloatMacro];
+    bytes_per_sample += io_size;
+
+    auto block_size = [&](int cache_size) {
+        int res = 0;
+        for (int size = 1; size <= 4096; size *= 2) {
+            if (working_set + size * io_size <= cache_size) res = size;
+        }
+        return res;
+    };
+
+    fFootprint.push_back(make_pair("struct_size", struct_size));
+    fFootprint.push_back(make_pair("tables_size", tables_size));
+    fFootprint.push_back(make_pair("working_set_size", working_set));
+    fFootprint.push_back(make_pair("bytes_per_sample", bytes_per_sample));
+    fFootprint.push_back(make_pair("block_size_l1", block_size(32 * 1024)));
+    fFootprint.push_back(make_pair("block_size_l2", block_size(256 * 1024)));
+}
+
 BlockInst* CodeContainer::flattenFIR(void)
 {
     BlockInst* global_block = InstBuilder::genBlockInst();
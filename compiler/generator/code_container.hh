@@ -46,6 +46,7 @@
 #define fTableName string("table")
 
 class TextInstVisitor;
+struct StructAccessCounter;
 
 // Look for the name of a given subcontainer
 struct SearchSubcontainer : public DispatchVisitor {
@@ -80,6 +81,7 @@ class CodeContainer : public virtual Garbageable {
     bool fGeneratedSR;
 
     MemoryLayoutType fMemoryLayout;
+    vector<pair<string, int>> fFootprint;  // Cache footprint, exported in the JSON description (see generateFootprint)
 
     string fKlassName;
 
@@ -125,6 +127,9 @@ class CodeContainer : public virtual Garbageable {
 
     property<CodeLoop*> fLoopProperty;  ///< loops used to compute some signals
 
+    vector<string>      fProfileLabels;  ///< labels of the parts of 'compute' measured in -prof mode
+    map<CodeLoop*, int> fProfileSlots;   ///< measure slot of each DAG loop in -prof mode
+
     list<string> fUICode;
     list<string> fUIMacro;
     list<string> fUIMacroActives;
@@ -151,6 +156,12 @@ class CodeContainer : public virtual Garbageable {
                             bool omp = false);
     void generateDAGLoopInternal(CodeLoop* loop, BlockInst* block, DeclareVarInst* count, bool omp);
 
+    int            addProfileSlot(const string& label);
+    StatementInst* generateProfileStart(int slot);
+    StatementInst* generateProfileEnd(int slot);
+    string         getProfileLabel(CodeLoop* loop, int loop_num);
+    void           generateProfile();
+
     void printHeader(ostream& dst)
     {
         // defines the metadata we want to print as comments at the begin of in the file
@@ -244,6 +255,10 @@ class CodeContainer : public virtual Garbageable {
     void computeForwardDAG(lclgraph dag, int& loop_count, vector<int>& ready_loop);
     void sortDeepFirstDAG(CodeLoop* l, set<CodeLoop*>& visited, list<CodeLoop*>& result);
 
+    void countLoopAccesses(StructAccessCounter& counter);
+    void sortHotColdDeclarations();
+    void generateFootprint();
+
     // Should be implemented in subclasses
     virtual void generateLocalInputs(BlockInst* loop_code, const string& index) { faustassert(false); }
     virtual void generateLocalOutputs(BlockInst* loop_code, const string& index) { faustassert(false); }
@@ -356,6 +371,14 @@ class CodeContainer : public virtual Garbageable {
                       fMemoryLayout);
         generateUserInterface(visitor);
         generateMetaData(visitor);
+        if (gGlobal->gMemoryManager || fFootprint.size() > 0) {
+            // Delay lines size, and their size with power-of-two ring buffers only (see -dlt and -dlw)
+            visitor->declare("delay_lines_size", std::to_string(gGlobal->gDelayLinesSize.first).c_str());
+            visitor->declare("delay_lines_pow2_size", std::to_string(gGlobal->gDelayLinesSize.second).c_str());
+        }
+        for (const auto& it : fFootprint) {
+            visitor->declare(it.first.c_str(), std::to_string(it.second).c_str());
+        }
     }
     
     template <typename REAL>
@@ -117,6 +117,31 @@ string CPPCodeContainer::genFinal()
     return (gGlobal->gNoVirtual) ? " final" : "";
 }
 
+/*
+ With -fmv, 'compute' calls a 'computeTargets' method compiled in several versions
+ by the C++ compiler (see FAUST_TARGET_CLONES), the best one for the running CPU
+ being selected once when the code is loaded.
+*/
+void CPPCodeContainer::generateComputeDeclaration(int n)
+{
+    string args = (gGlobal->gInPlace) ? "(int $0, $1** inputs, $1** outputs) {"
+                                      : "(int $0, $1** RESTRICT inputs, $1** RESTRICT outputs) {";
+    if (gGlobal->gMultiVersioning) {
+        *fOut << genVirtual() << subst("void compute" + args, fFullCount, xfloat());
+        tab(n + 2, *fOut);
+        *fOut << subst("computeTargets($0, inputs, outputs);", fFullCount);
+        tab(n + 1, *fOut);
+        *fOut << "}";
+        tab(n + 1, *fOut);
+        tab(n + 1, *fOut);
+        *fOut << "FAUST_TARGET_CLONES";
+        tab(n + 1, *fOut);
+        *fOut << subst("void computeTargets" + args, fFullCount, xfloat());
+    } else {
+        *fOut << genVirtual() << subst("void compute" + args, fFullCount, xfloat());
+    }
+}
+
 // Scalar
 CPPScalarCodeContainer::CPPScalarCodeContainer(const string& name, const string& super, int numInputs, int numOutputs,
                                                std::ostream* out, int sub_container_type)
@@ -156,6 +181,27 @@ void CPPCodeContainer::produceMetadata(int tabs)
     *fOut << "}" << endl;
 }
 
+/*
+ With -prof, the 'profile' method gives the label of each measured part of 'compute'
+ and the cycles spent in it since the last 'instanceClear', for instance with
+ a JSONUI object (in its "meta" section).
+*/
+void CPPCodeContainer::produceProfile(int tabs)
+{
+    tab(tabs, *fOut);
+    *fOut << "void profile(Meta* m) { ";
+    tab(tabs + 1, *fOut);
+    *fOut << "m->declare(\"profile_unit\", FAUST_PROFILE_UNIT);";
+    for (size_t i = 0; i < fProfileLabels.size(); i++) {
+        tab(tabs + 1, *fOut);
+        *fOut << "m->declare(\"profile" << i << "\", \"" << fProfileLabels[i] << "\");";
+        tab(tabs + 1, *fOut);
+        *fOut << "m->declare(\"profile" << i << "_cycles\", std::to_string(iProfileCycles" << i << ").c_str());";
+    }
+    tab(tabs, *fOut);
+    *fOut << "}" << endl;
+}
+
 void CPPCodeContainer::produceInit(int tabs)
 {
     if (gGlobal->gMemoryManager) {
@@ -314,6 +360,40 @@ void CPPCodeContainer::produceClass()
     *fOut << "#else" << endl;
     *fOut << "#define RESTRICT __restrict__" << endl;
     *fOut << "#endif" << endl;
+    
+    if (gGlobal->gMultiVersioning) {
+        tab(n, *fOut);
+        *fOut << "#ifndef FAUST_TARGET_CLONES" << endl;
+        *fOut << "#if defined(__x86_64__) && defined(__ELF__) && ((defined(__clang__) && __clang_major__ >= 14) || (!defined(__clang__) && __GNUC__ >= 6))" << endl;
+        *fOut << "#define FAUST_TARGET_CLONES __attribute__((target_clones(\"arch=skylake-avx512\", \"arch=haswell\", \"default\")))" << endl;
+        *fOut << "#else" << endl;
+        *fOut << "#define FAUST_TARGET_CLONES" << endl;
+        *fOut << "#endif" << endl;
+        *fOut << "#endif" << endl;
+    }
+
+    if (gGlobal->gProfileLoops) {
+        tab(n, *fOut);
+        *fOut << "#ifndef FAUST_PROFILE_CYCLES" << endl;
+        *fOut << "#define FAUST_PROFILE_CYCLES" << endl;
+        *fOut << "#include <stdint.h>" << endl;
+        *fOut << "#include <string>" << endl;
+        *fOut << "#if defined(_MSC_VER)" << endl;
+        *fOut << "#include <intrin.h>" << endl;
+        *fOut << "#define FAUST_PROFILE_UNIT \"cycles\"" << endl;
+        *fOut << "static inline int64_t faustProfileCycles() { return int64_t(__rdtsc()); }" << endl;
+        *fOut << "#elif defined(__x86_64__) || defined(__i386__)" << endl;
+        *fOut << "#include <x86intrin.h>" << endl;
+        *fOut << "#define FAUST_PROFILE_UNIT \"cycles\"" << endl;
+        *fOut << "static inline int64_t faustProfileCycles() { return int64_t(__rdtsc()); }" << endl;
+        *fOut << "#else" << endl;
+        *fOut << "#include <time.h>" << endl;
+        *fOut << "#define FAUST_PROFILE_UNIT \"ns\"" << endl;
+        *fOut << "static inline int64_t faustProfileCycles() { struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts); "
+                 "return int64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec; }" << endl;
+        *fOut << "#endif" << endl;
+        *fOut << "#endif" << endl;
+    }
 
     // Generate gub containers
     generateSubContainers();
@@ -403,6 +483,11 @@ void CPPCodeContainer::produceClass()
     // Print metadata declaration
     tab(n + 1, *fOut);
     produceMetadata(n + 1);
+    
+    if (gGlobal->gProfileLoops) {
+        tab(n + 1, *fOut);
+        produceProfile(n + 1);
+    }
 
     tab(n + 1, *fOut);
     // No class name for main class
@@ -1916,11 +2001,7 @@ void CPPScalarCodeContainer::generateCompute(int n)
     // Generates declaration
     tab(n + 1, *fOut);
     tab(n + 1, *fOut);
-    if (gGlobal->gInPlace) {
-        *fOut << genVirtual() << subst("void compute(int $0, $1** inputs, $1** outputs) {", fFullCount, xfloat());
-    } else {
-        *fOut << genVirtual() << subst("void compute(int $0, $1** RESTRICT inputs, $1** RESTRICT outputs) {", fFullCount, xfloat());
-    }
+    generateComputeDeclaration(n);
     tab(n + 2, *fOut);
     fCodeProducer->Tab(n + 2);
     
@@ -2041,11 +2122,7 @@ void CPPVectorCodeContainer::generateCompute(int n)
 
     // Generates declaration
     tab(n + 1, *fOut);
-    if (gGlobal->gInPlace) {
-        *fOut << genVirtual() << subst("void compute(int $0, $1** inputs, $1** outputs) {", fFullCount, xfloat());
-    } else {
-        *fOut << genVirtual() << subst("void compute(int $0, $1** RESTRICT inputs, $1** RESTRICT outputs) {", fFullCount, xfloat());
-    }
+    generateComputeDeclaration(n);
     tab(n + 2, *fOut);
     fCodeProducer->Tab(n + 2);
 
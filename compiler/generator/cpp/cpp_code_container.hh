@@ -45,10 +45,13 @@ class CPPCodeContainer : public virtual CodeContainer {
     std::string    fSuperKlassName;
 
     void produceMetadata(int tabs);
+    void produceProfile(int tabs);
     void produceInit(int tabs);
     
     std::string genVirtual();
     std::string genFinal();
+    
+    void generateComputeDeclaration(int tabs);
   
    public:
     CPPCodeContainer()
@@ -61,8 +64,7 @@ class CPPCodeContainer : public virtual CodeContainer {
 
         // For mathematical functions
         if (gGlobal->gFastMath) {
-            addIncludeFile((gGlobal->gFastMathLib == "def") ? "\"faust/dsp/fastmath.cpp\""
-                                                            : ("\"" + gGlobal->gFastMathLib + "\""));
+            addIncludeFile("\"" + gGlobal->getFastMathFile() + "\"");
         } else {
             addIncludeFile("<cmath>");
             addIncludeFile("<algorithm>");
@@ -143,8 +145,7 @@ class CPPScalarOneSampleCodeContainer1 : public CPPScalarCodeContainer {
         
         // For mathematical functions
         if (gGlobal->gFastMath) {
-            addIncludeFile((gGlobal->gFastMathLib == "def") ? "\"faust/dsp/fastmath.cpp\""
-                           : ("\"" + gGlobal->gFastMathLib + "\""));
+            addIncludeFile("\"" + gGlobal->getFastMathFile() + "\"");
         } else {
             addIncludeFile("<cmath>");
             addIncludeFile("<algorithm>");
@@ -179,8 +180,7 @@ class CPPScalarOneSampleCodeContainer2 : public CPPScalarCodeContainer {
             
             // For mathematical functions
             if (gGlobal->gFastMath) {
-                addIncludeFile((gGlobal->gFastMathLib == "def") ? "\"faust/dsp/fastmath.cpp\""
-                               : ("\"" + gGlobal->gFastMathLib + "\""));
+                addIncludeFile("\"" + gGlobal->getFastMathFile() + "\"");
             } else {
                 addIncludeFile("<cmath>");
                 addIncludeFile("<algorithm>");
@@ -213,8 +213,7 @@ class CPPScalarOneSampleCodeContainer3 : public CPPScalarOneSampleCodeContainer2
             
             // For mathematical functions
             if (gGlobal->gFastMath) {
-                addIncludeFile((gGlobal->gFastMathLib == "def") ? "\"faust/dsp/fastmath.cpp\""
-                               : ("\"" + gGlobal->gFastMathLib + "\""));
+                addIncludeFile("\"" + gGlobal->getFastMathFile() + "\"");
             } else {
                 addIncludeFile("<cmath>");
                 addIncludeFile("<algorithm>");
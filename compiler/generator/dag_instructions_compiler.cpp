@@ -125,9 +125,13 @@ void DAGInstructionsCompiler::compileMultiSignal(Tree L)
     if (fDescription) {
         fDescription->ui(prepareUserInterfaceTree(fUIRoot));
     }
+    
+    checkFTZVars();
 
     // Apply FIR to FIR transformations
+    startTiming("processFIR");
     fContainer->processFIR();
+    endTiming("processFIR");
     
     endTiming("compileMultiSignal");
 }
@@ -406,6 +410,15 @@ ValueInst* DAGInstructionsCompiler::generateVariableStore(Tree sig, ValueInst* e
     }
 }
 
+/**
+ * The prefix value lives in a scalar of the compute block, only valid inside the loop that computes it.
+ * When the prefix is shared or delayed, it is cached in a vector to be used by the other loops.
+ */
+ValueInst* DAGInstructionsCompiler::generatePrefix(Tree sig, Tree x, Tree e)
+{
+    return generateCacheCode(sig, InstructionsCompiler::generatePrefix(sig, x, e));
+}
+
 ValueInst* DAGInstructionsCompiler::generateInput(Tree sig, int idx)
 {
     if (gGlobal->gOpenCLSwitch || gGlobal->gCUDASwitch) {  // HACK
@@ -552,6 +565,7 @@ void DAGInstructionsCompiler::generateDlineLoop(Typed::VarType ctype, const stri
 
         // allocate permanent storage for delayed samples
         pushClearMethod(generateInitArray(pmem, ctype, delay));
+        addDelayLineSize(ctype, delay, delay);
 
         // compute method
 
@@ -587,6 +601,7 @@ void DAGInstructionsCompiler::generateDlineLoop(Typed::VarType ctype, const stri
 
         // allocate permanent storage for delayed samples
         pushClearMethod(generateInitArray(vname, ctype, delay));
+        addDelayLineSize(ctype, delay, delay);
         pushDeclare(InstBuilder::genDecStructVar(idx, InstBuilder::genInt32Typed()));
         pushDeclare(InstBuilder::genDecStructVar(idx_save, InstBuilder::genInt32Typed()));
 
@@ -48,6 +48,7 @@ class DAGInstructionsCompiler : public InstructionsCompiler {
     virtual ValueInst* generateVariableStore(Tree sig, ValueInst* inst);
     virtual ValueInst* generateCacheCode(Tree sig, ValueInst* inst);
     virtual ValueInst* generateInput(Tree sig, int idx);
+    virtual ValueInst* generatePrefix(Tree sig, Tree x, Tree e);
 
     virtual ValueInst* generateDelay(Tree sig, Tree arg, Tree size);
     virtual ValueInst* generateDelayVec(Tree sig, ValueInst* exp, Typed::VarType ctype, const string& vname, int mxd);
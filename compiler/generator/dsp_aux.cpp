@@ -133,6 +133,7 @@ static vector<string> reorganizeCompilationOptionsAux(vector<string>& options)
     addKeyValueIfExisting(options, newoptions, "-mcd", "16");
     addKeyValueIfExisting(options, newoptions, "-cn", "");
     addKeyValueIfExisting(options, newoptions, "-ftz", "0");
+    addKeyValueIfExisting(options, newoptions, "-ftzv", "");
 
     //------STEP4 - Add other types of Faust options
     /*
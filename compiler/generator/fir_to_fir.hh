@@ -503,6 +503,36 @@ struct VariableSizeCounter : public DispatchVisitor {
     }
 };
 
+// Count the read/write accesses of struct variables
+struct StructAccessCounter : public DispatchVisitor {
+
+    map<string, int> fAccessCount;
+
+    void count(Address* address)
+    {
+        if (address->getAccess() & (Address::kStruct | Address::kStaticStruct)) {
+            fAccessCount[address->getName()]++;
+        }
+    }
+
+    virtual void visit(LoadVarInst* inst)
+    {
+        count(inst->fAddress);
+        DispatchVisitor::visit(inst);
+    }
+
+    virtual void visit(StoreVarInst* inst)
+    {
+        count(inst->fAddress);
+        DispatchVisitor::visit(inst);
+    }
+
+    int getAccessCount(const string& name)
+    {
+        return (fAccessCount.find(name) != fAccessCount.end()) ? fAccessCount[name] : 0;
+    }
+};
+
 // Remove unneeded cast
 struct CastRemover : public BasicTypingCloneVisitor {
     
@@ -1529,8 +1529,13 @@ class BasicCloneVisitor : public CloneVisitor {
     // Loop
     virtual StatementInst* visit(ForLoopInst* inst)
     {
-        return new ForLoopInst(inst->fInit->clone(this), inst->fEnd->clone(this), inst->fIncrement->clone(this),
-                               static_cast<BlockInst*>(inst->fCode->clone(this)), inst->fIsRecursive);
+        // Clone in a defined order (arguments evaluation order is unspecified), since
+        // renaming visitors have to see the loop variable declaration first
+        StatementInst* init      = inst->fInit->clone(this);
+        ValueInst*     end       = inst->fEnd->clone(this);
+        StatementInst* increment = inst->fIncrement->clone(this);
+        BlockInst*     code      = static_cast<BlockInst*>(inst->fCode->clone(this));
+        return new ForLoopInst(init, end, increment, code, inst->fIsRecursive);
     }
 
     virtual StatementInst* visit(SimpleForLoopInst* inst)
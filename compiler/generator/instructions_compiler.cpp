@@ -34,6 +34,7 @@
 #include "prim2.hh"
 #include "privatise.hh"
 #include "recursivness.hh"
+#include "sigBinding.hh"
 #include "sigConstantPropagation.hh"
 #include "sigPromotion.hh"
 #include "sigToGraph.hh"
@@ -224,6 +225,14 @@ Tree InstructionsCompiler::prepare(Tree LS)
     Tree L1 = deBruijn2Sym(LS);  // Convert deBruijn recursion into symbolic recursion
     endTiming("deBruijn2Sym");
 
+    if (gGlobal->gLiveOutputs.size() > 0 || gGlobal->gFrozenControls.size() > 0) {
+        startTiming("SignalBinding");
+        // Specialize for the instance configuration, dead subgraphs will be removed by simplification
+        SignalBinding SB(gGlobal->gLiveOutputs, gGlobal->gFrozenControls);
+        L1 = SB.bind(L1);
+        endTiming("SignalBinding");
+    }
+
     startTiming("L1 typeAnnotation");
     // Annotate L1 with type information (needed by castAndPromotion(), but don't check causality)
     typeAnnotation(L1, gGlobal->gLocalCausalityCheck);
@@ -612,7 +621,11 @@ void InstructionsCompiler::compileMultiSignal(Tree L)
     }
 
     // Apply FIR to FIR transformations
+    checkFTZVars();
+
+    startTiming("processFIR");
     fContainer->processFIR();
+    endTiming("processFIR");
 
     endTiming("compileMultiSignal");
 }
@@ -1844,10 +1857,19 @@ ValueInst* InstructionsCompiler::generateRec(Tree sig, Tree var, Tree le, int in
         if (used[i]) {
             Address::AccessType var_access;
             ValueInst* ccs = getConditionCode(nth(le, i));
+            // With -ftzv, the FTZ code is only kept for the listed variables
+            Tree exp = nth(le, i), x;
+            if (gGlobal->gFTZVars.size() > 0) {
+                if (gGlobal->gFTZVars.find(vname[i]) == gGlobal->gFTZVars.end()) {
+                    if (isSigFTZ(exp, x)) exp = x;
+                } else {
+                    gGlobal->gFTZFoundVars.insert(vname[i]);
+                }
+            }
             if (index == i) {
-                res = generateDelayLine(CS(nth(le, i)), ctype[i], vname[i], delay[i], var_access, ccs);
+                res = generateDelayLine(CS(exp), ctype[i], vname[i], delay[i], var_access, ccs);
             } else {
-                generateDelayLine(CS(nth(le, i)), ctype[i], vname[i], delay[i], var_access, ccs);
+                generateDelayLine(CS(exp), ctype[i], vname[i], delay[i], var_access, ccs);
             }
         }
     }
@@ -1855,6 +1877,16 @@ ValueInst* InstructionsCompiler::generateRec(Tree sig, Tree var, Tree le, int in
     return res;
 }
 
+// Each -ftzv variable has to be one of the compiled recursions
+void InstructionsCompiler::checkFTZVars()
+{
+    for (const auto& var : gGlobal->gFTZVars) {
+        if (gGlobal->gFTZFoundVars.find(var) == gGlobal->gFTZFoundVars.end()) {
+            throw faustexception("ERROR : '-ftzv' variable '" + var + "' does not match any recursive variable\n");
+        }
+    }
+}
+
 /*****************************************************************************
  PREFIX, DELAY A PREFIX VALUE
  *****************************************************************************/
@@ -1989,13 +2021,158 @@ ValueInst* InstructionsCompiler::generateXtended(Tree sig)
         arg_types.push_back(getCertifiedSigType(sig->branch(i)));
     }
 
-    if (p->needCache()) {
+    if (isControlRateXtended(sig)) {
+        return generateControlRateXtended(sig, p->generateCode(fContainer, args, getCertifiedSigType(sig), arg_types));
+    } else if (p->needCache()) {
         return generateCacheCode(sig, p->generateCode(fContainer, args, getCertifiedSigType(sig), arg_types));
     } else {
         return p->generateCode(fContainer, args, getCertifiedSigType(sig), arg_types);
     }
 }
 
+/*****************************************************************************
+ CONTROL RATE INTERPOLATION (-cri <N>)
+
+ Expensive functions (pow, exp, sin...) of smoothed controls are kSamp and
+ would be computed at each sample. They are instead computed every N samples
+ and linearly interpolated in between:
+
+ if (iSubBlock == 0) { fPrev = fTarget; fTarget = f(x); }
+ if (iCRFirst == 1) { fPrev = fTarget; }
+ y = fPrev + (fTarget - fPrev) * (iSubBlock + 1) / N
+
+ with 'iCRFirst' only set for the first sample after instanceClear.
+
+ *****************************************************************************/
+
+/**
+ * A smoother is a one pole recursion 'y = a + k * y'' where 'a' and 'k' are control rate signals,
+ * like the ones produced by si.smoo or si.smooth.
+ */
+bool InstructionsCompiler::isSmootherProj(Tree sig)
+{
+    int  i, d;
+    Tree group, var, le, a, b, y, z;
+    if (!isProj(sig, &i, group) || !isRec(group, var, le) || isNil(le) || len(le) != 1) return false;
+
+    // Recognize 'x' as a one sample delayed projection of the recursion
+    auto isSelf = [var](Tree t) {
+        int  j, k;
+        Tree u, v, w;
+        return (isSigDelay1(t, u) || (isSigDelay(t, u, w) && isSigInt(w, &k) && k == 1)) && isProj(u, &j, v) &&
+               (v == var || (isRef(v, w) && w == var) || (isRec(v, w, u) && w == var));
+    };
+
+    // Recognize 'k * y''
+    auto isScaledSelf = [&](Tree t) {
+        double k;
+        if (!isSigMul(t, y, z)) return false;
+        if (isSelf(z)) std::swap(y, z);
+        if (!isSelf(y)) return false;
+        // A numerical coefficient has to be a 'leaky' one
+        return (isSigReal(z, &k) || (isSigInt(z, &d) && (k = d, true))) ? (fabs(k) < 1.) : isControlRate(z);
+    };
+
+    Tree def = hd(le);
+    if (!isSigAdd(def, a, b)) return false;
+    if (isScaledSelf(a)) std::swap(a, b);
+    return isScaledSelf(b) && isControlRate(a);
+}
+
+/**
+ * Control rate signals only depend on constants, controls and smoothed controls.
+ */
+bool InstructionsCompiler::isControlRate(Tree sig)
+{
+    bool res;
+    if (fControlRateProperty.get(sig, res)) return res;
+
+    int    i;
+    double r;
+    Tree   label, c, x, y, z, type, name, file;
+
+    if (isSigInt(sig, &i) || isSigReal(sig, &r) || isSigFConst(sig, type, name, file) ||
+        isSigFVar(sig, type, name, file) || isSigButton(sig, label) || isSigCheckbox(sig, label) ||
+        isSigVSlider(sig, label, c, x, y, z) || isSigHSlider(sig, label, c, x, y, z) ||
+        isSigNumEntry(sig, label, c, x, y, z)) {
+        res = true;
+    } else if (isSigDelay(sig, x, y) && isSigInt(y, &i) && (i == 0)) {
+        res = isControlRate(x);
+    } else if (getUserData(sig) || isSigBinOp(sig, &i, x, y) || isSigIntCast(sig, x) || isSigFloatCast(sig, x) ||
+               isSigSelect2(sig, c, x, y)) {
+        // Avoid infinite recursion through a recursive group
+        fControlRateProperty.set(sig, false);
+        res = true;
+        for (Tree b : sig->branches()) {
+            res &= isControlRate(b);
+        }
+    } else {
+        fControlRateProperty.set(sig, false);
+        res = isSmootherProj(sig);
+    }
+
+    fControlRateProperty.set(sig, res);
+    return res;
+}
+
+bool InstructionsCompiler::isControlRateXtended(Tree sig)
+{
+    static set<string> expensive = {"pow", "exp", "exp10", "log", "log10", "sin", "cos", "tan",
+                                    "asin", "acos", "atan", "atan2", "sqrt"};
+
+    if (gGlobal->gControlRateInterp <= 1) return false;
+
+    xtended* p = (xtended*)getUserData(sig);
+    ::Type   t = getCertifiedSigType(sig);
+    // Only sample rate real expressions not already under a condition
+    return (expensive.find(p->name()) != expensive.end()) && (t->variability() == kSamp) && (t->nature() == kReal) &&
+           dynamic_cast<NullValueInst*>(getConditionCode(sig)) && isControlRate(sig);
+}
+
+ValueInst* InstructionsCompiler::generateControlRateXtended(Tree sig, ValueInst* exp)
+{
+    int N = gGlobal->gControlRateInterp;
+    
+    // Unique sub-block counter
+    if (fCurrentSubBlock == "") {
+        fCurrentSubBlock = gGlobal->getFreshID("iSubBlock");
+        pushDeclare(InstBuilder::genDecStructVar(fCurrentSubBlock, InstBuilder::genInt32Typed()));
+        pushClearMethod(InstBuilder::genStoreStructVar(fCurrentSubBlock, InstBuilder::genInt32NumInst(0)));
+        
+        FIRIndex value = (FIRIndex(InstBuilder::genLoadStructVar(fCurrentSubBlock)) + 1) % N;
+        pushPostComputeDSPMethod(InstBuilder::genStoreStructVar(fCurrentSubBlock, value));
+
+        // First sample after instanceClear
+        fCurrentCRFirst = gGlobal->getFreshID("iCRFirst");
+        pushDeclare(InstBuilder::genDecStructVar(fCurrentCRFirst, InstBuilder::genInt32Typed()));
+        pushClearMethod(InstBuilder::genStoreStructVar(fCurrentCRFirst, InstBuilder::genInt32NumInst(1)));
+        pushPostComputeDSPMethod(InstBuilder::genStoreStructVar(fCurrentCRFirst, InstBuilder::genInt32NumInst(0)));
+    }
+    
+    string prev   = gGlobal->getFreshID("fCRPrev");
+    string target = gGlobal->getFreshID("fCRTarget");
+    pushDeclare(InstBuilder::genDecStructVar(prev, InstBuilder::genBasicTyped(itfloat())));
+    pushDeclare(InstBuilder::genDecStructVar(target, InstBuilder::genBasicTyped(itfloat())));
+    pushClearMethod(InstBuilder::genStoreStructVar(prev, InstBuilder::genTypedZero(itfloat())));
+    pushClearMethod(InstBuilder::genStoreStructVar(target, InstBuilder::genTypedZero(itfloat())));
+    
+    // Compute the new target at the beginning of each sub-block
+    ValueInst* cond = FIRIndex(InstBuilder::genLoadStructVar(fCurrentSubBlock)) == 0;
+    pushComputeDSPMethod(InstBuilder::genControlInst(cond, InstBuilder::genStoreStructVar(prev, InstBuilder::genLoadStructVar(target))));
+    pushComputeDSPMethod(InstBuilder::genControlInst(cond, InstBuilder::genStoreStructVar(target, exp)));
+
+    // No ramp in the first sub-block, which starts with the current value as with the non-interpolated code
+    ValueInst* first = FIRIndex(InstBuilder::genLoadStructVar(fCurrentCRFirst)) == 1;
+    pushComputeDSPMethod(InstBuilder::genControlInst(first, InstBuilder::genStoreStructVar(prev, InstBuilder::genLoadStructVar(target))));
+    
+    // Linear interpolation
+    ValueInst* ramp = InstBuilder::genMul(InstBuilder::genCastInst(FIRIndex(InstBuilder::genLoadStructVar(fCurrentSubBlock)) + 1,
+                                                                   InstBuilder::genBasicTyped(itfloat())),
+                                          InstBuilder::genRealNumInst(itfloat(), 1.0 / double(N)));
+    ValueInst* delta = InstBuilder::genSub(InstBuilder::genLoadStructVar(target), InstBuilder::genLoadStructVar(prev));
+    return generateCacheCode(sig, InstBuilder::genAdd(InstBuilder::genLoadStructVar(prev), InstBuilder::genMul(delta, ramp)));
+}
+
 /*****************************************************************************
  N-SAMPLE FIXED DELAY : sig = exp@delay
 
@@ -2050,7 +2227,7 @@ ValueInst* InstructionsCompiler::generateDelay(Tree sig, Tree exp, Tree delay)
     } else {
 
         int N = pow2limit(mxd + 1);
-        if (N <= gGlobal->gMaskDelayLineThreshold) {
+        if (isMaskDelayLine(mxd)) {
             
             ensureIotaCode();
             
@@ -2162,6 +2339,7 @@ ValueInst* InstructionsCompiler::generateDelayLine(ValueInst* exp, Typed::VarTyp
 
         // Generates table init
         pushClearMethod(generateInitArray(vname, ctype, mxd + 1));
+        addDelayLineSize(ctype, mxd + 1, mxd + 1);
 
         // Generate table use
         pushComputeDSPMethod(InstBuilder::genControlInst(ccs, InstBuilder::genStoreArrayStructVar(vname, InstBuilder::genInt32NumInst(0), exp)));
@@ -2179,12 +2357,13 @@ ValueInst* InstructionsCompiler::generateDelayLine(ValueInst* exp, Typed::VarTyp
     } else {
 
         int N = pow2limit(mxd + 1);
-        if (N <= gGlobal->gMaskDelayLineThreshold) {
+        if (isMaskDelayLine(mxd)) {
 
             ensureIotaCode();
 
             // Generates table init
             pushClearMethod(generateInitArray(vname, ctype, N));
+            addDelayLineSize(ctype, N, N);
 
             // Generate table use
             if (gGlobal->gComputeIOTA) {  // Ensure IOTA base fixed delays are computed once
@@ -2217,6 +2396,7 @@ ValueInst* InstructionsCompiler::generateDelayLine(ValueInst* exp, Typed::VarTyp
 
             // Generates table init
             pushClearMethod(generateInitArray(vname, ctype, mxd + 1));
+            addDelayLineSize(ctype, mxd + 1, N);
 
             // int w = widx;
             pushComputeDSPMethod(InstBuilder::genControlInst(ccs, InstBuilder::genDecStackVar(widx_tmp_name, InstBuilder::genBasicTyped(Typed::kInt32), InstBuilder::genLoadStructVar(widx_name))));
@@ -64,6 +64,11 @@ class InstructionsCompiler : public virtual Garbageable {
     // Several 'IOTA' variables may be needed when subcontainers are inlined in the main module
     string fCurrentIOTA;
 
+    // Sub-block counter and control rate signals (see -cri)
+    string         fCurrentSubBlock;
+    string         fCurrentCRFirst;
+    property<bool> fControlRateProperty;
+
     Tree         fUIRoot;
     Description* fDescription;
     
@@ -138,6 +143,23 @@ class InstructionsCompiler : public virtual Garbageable {
         return x && (!(x&(x-1)));
     }
 
+    /*
+     -dlw <P> : a 'mask' delay line is only used when at most P% of its power-of-two size is unused,
+     otherwise the exact size 'select' delay line is used.
+    */
+    bool isMaskDelayLine(int mxd)
+    {
+        int N = pow2limit(mxd + 1);
+        return (N <= gGlobal->gMaskDelayLineThreshold) && (100. * double(N - (mxd + 1)) <= double(gGlobal->gMaskDelayLineWaste) * N);
+    }
+
+    // Keep delay lines size in bytes, and their size if all ring buffers were power-of-two sized
+    void addDelayLineSize(Typed::VarType ctype, int size, int pow2_size)
+    {
+        gGlobal->gDelayLinesSize.first += size * gGlobal->gTypeSizeMap[ctype];
+        gGlobal->gDelayLinesSize.second += pow2_size * gGlobal->gTypeSizeMap[ctype];
+    }
+
     CodeContainer* signal2Container(const string& name, Tree sig);
 
     int  getSharingCount(Tree sig);
@@ -171,6 +193,8 @@ class InstructionsCompiler : public virtual Garbageable {
 
     virtual void compileMultiSignal(Tree sig);
     virtual void compileSingleSignal(Tree sig);
+    
+    void checkFTZVars();
 
     virtual ValueInst* generateVariableStore(Tree sig, ValueInst* inst);
     virtual ValueInst* generateCacheCode(Tree sig, ValueInst* inst);
@@ -180,6 +204,12 @@ class InstructionsCompiler : public virtual Garbageable {
     virtual ValueInst* generateCode(Tree sig);
 
     virtual ValueInst* generateXtended(Tree sig);
+
+    bool       isSmootherProj(Tree sig);
+    bool       isControlRate(Tree sig);
+    bool       isControlRateXtended(Tree sig);
+    ValueInst* generateControlRateXtended(Tree sig, ValueInst* exp);
+
     virtual ValueInst* generateDelay(Tree sig, Tree arg, Tree size);
     virtual ValueInst* generatePrefix(Tree sig, Tree x, Tree e);
     virtual ValueInst* generateBinOp(Tree sig, int opcode, Tree arg1, Tree arg2);
@@ -32,6 +32,7 @@
 
 #include "exception.hh"
 #include "fbc_executor.hh"
+#include "fbc_profile.hh"
 #include "interpreter_bytecode.hh"
 #include "dsp_aux.hh"
 
@@ -40,11 +41,14 @@
 
  Trace mode: only check 'non-optimized' interpreter operations, since the code is not optimized in this case.
 
- 1 : collect FP_SUBNORMAL only
+ 1 : collect FP_SUBNORMAL only (also counted for each stored variable, to find the recursive ones needing -ftzv)
  2 : collect FP_SUBNORMAL, FP_INFINITE and FP_NAN
  3 : collect FP_SUBNORMAL, FP_INFINITE, FP_NAN, INTEGER_OVERFLOW and DIV_BY_ZERO
  4 : collect FP_SUBNORMAL, FP_INFINITE, FP_NAN, INTEGER_OVERFLOW, DIV_BY_ZERO, fails at first FP_INFINITE or FP_NAN
  5 : collect FP_SUBNORMAL, FP_INFINITE, FP_NAN, INTEGER_OVERFLOW, DIV_BY_ZERO, continue after FP_INFINITE or FP_NAN
+ 6 : only check LOAD/STORE errors and continue
+ 7 : only check LOAD/STORE errors and exit
+ 8 : profile the optimized code (see FBCProfile), also checking LOAD/STORE errors like 6
 */
 
 #define INTEGER_OVERFLOW -1
@@ -107,6 +111,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
     REAL** fOutputs;
 
     std::map<int, int64_t> fRealStats;
+    std::map<std::string, int64_t> fSubnormalStores;  // Subnormal values stored in each variable
+    
+    FBCProfile<REAL>* fProfile;
     
     /*
      Keeps the latest TRACE_STACK_SIZE executed instructions, to be displayed when an error occurs.
@@ -170,6 +177,20 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         fTraceContext.traceInstruction(it, int_value, real_value);
     }
 
+    void printProfile()
+    {
+        if (TRACE == 8) {
+            std::vector<std::pair<std::string, FBCBlockInstruction<REAL>*>> blocks;
+            blocks.push_back(std::make_pair("staticInit", fFactory->fStaticInitBlock));
+            blocks.push_back(std::make_pair("init", fFactory->fInitBlock));
+            blocks.push_back(std::make_pair("resetUI", fFactory->fResetUIBlock));
+            blocks.push_back(std::make_pair("clear", fFactory->fClearBlock));
+            blocks.push_back(std::make_pair("compute control", fFactory->fComputeBlock));
+            blocks.push_back(std::make_pair("compute DSP", fFactory->fComputeDSPBlock));
+            fProfile->print(&std::cout, blocks, fFactory->fHeapNames);
+        }
+    }
+
     void printStats()
     {
         if (TRACE > 0 && TRACE < 6) {
@@ -177,6 +198,7 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             std::cout << "Interpreter statistics" << std::endl;
             if (TRACE >= 1) {
                 std::cout << "FP_SUBNORMAL: " << fRealStats[FP_SUBNORMAL] << std::endl;
+                printSubnormalStores();
             }
             if (TRACE >= 2) {
                 std::cout << "FP_INFINITE: " << fRealStats[FP_INFINITE] << std::endl;
@@ -192,6 +214,30 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         }
     }
 
+    // Variables receiving subnormal values, and the recursive ones (fRecXX) to be flushed with -ftzv
+    void printSubnormalStores()
+    {
+        if (fSubnormalStores.size() == 0) return;
+        std::vector<std::pair<std::string, int64_t>> stores(fSubnormalStores.begin(), fSubnormalStores.end());
+        std::sort(stores.begin(), stores.end(),
+                  [](const std::pair<std::string, int64_t>& a, const std::pair<std::string, int64_t>& b) {
+                      return a.second > b.second;
+                  });
+        std::stringstream vars;
+        std::string       sep = "";
+        std::cout << "FP_SUBNORMAL stores:" << std::endl;
+        for (const auto& it : stores) {
+            std::cout << "  " << it.first << ": " << it.second << std::endl;
+            if (it.first.compare(0, 4, "fRec") == 0) {
+                vars << sep << it.first;
+                sep = ",";
+            }
+        }
+        if (vars.str() != "") {
+            std::cout << "FTZ_VARIABLES: " << vars.str() << std::endl;
+        }
+    }
+
     inline void warningOverflow(InstructionIT it)
     {
         if (TRACE >= 6) return;
@@ -270,6 +316,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         if (TRACE >= 1) {
             if (std::fpclassify(val) == FP_SUBNORMAL) {
                 fRealStats[FP_SUBNORMAL]++;
+                if ((*it)->fOpcode == FBCInstruction::kStoreReal || (*it)->fOpcode == FBCInstruction::kStoreIndexedReal) {
+                    fSubnormalStores[(*it)->fName]++;
+                }
             }
         }
 
@@ -650,7 +699,7 @@ class FBCInterpreter : public FBCExecutor<REAL> {
     }
 #define dispatchNextScal()    \
     {                         \
-        if (TRACE >= 4) {     \
+        if (TRACE >= 4 && TRACE != 8) {     \
             traceInstruction(it, int_stack[int_stack_index], real_stack[real_stack_index]); \
         }                     \
         it++;                 \
@@ -692,6 +741,7 @@ class FBCInterpreter : public FBCExecutor<REAL> {
     
         loop:
             // (*it)->write(&std::cout);
+            if (TRACE == 8) fProfile->enter(*it);
             switch ((*it)->fOpcode) {
                     
                 // Number operations
@@ -2589,6 +2639,7 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             }
         
     end:
+        if (TRACE == 8) fProfile->leave();
         // Check stack coherency
         assertInterp(real_stack_index == 0 && int_stack_index == 0);
     }
@@ -2710,11 +2761,12 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
 #define dispatchFirstScal()                   \
     {                                         \
+        if (TRACE == 8) fProfile->enter(*it); \
         goto *fDispatchTable[(*it)->fOpcode]; \
     }
 #define dispatchNextScal()                    \
     {                                         \
-        if (TRACE >= 4) {     \
+        if (TRACE >= 4 && TRACE != 8) {     \
             traceInstruction(it, int_stack[int_stack_index], real_stack[real_stack_index]); \
         }                                     \
         it++;                                 \
@@ -4639,6 +4691,7 @@ class FBCInterpreter : public FBCExecutor<REAL> {
     }
 
     end:
+        if (TRACE == 8) fProfile->leave();
         // Check stack coherency
         assertInterp(real_stack_index == 0 && int_stack_index == 0);
     }
@@ -4659,7 +4712,7 @@ class FBCInterpreter : public FBCExecutor<REAL> {
    
         if (fFactory->getMemoryManager()) {
             fRealHeap  = static_cast<REAL*>(fFactory->allocate(sizeof(REAL) * fFactory->fRealHeapSize));
-            fIntHeap   = static_cast<int*>(fFactory->allocate(sizeof(REAL) * fFactory->fIntHeapSize));
+            fIntHeap   = static_cast<int*>(fFactory->allocate(sizeof(int) * fFactory->fIntHeapSize));
             fInputs    = static_cast<REAL**>(fFactory->allocate(sizeof(REAL*) * fFactory->fNumInputs));
             fOutputs   = static_cast<REAL**>(fFactory->allocate(sizeof(REAL*) * fFactory->fNumOutputs));
         } else {
@@ -4688,6 +4741,8 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         fRealStats[FP_NAN]            = 0;
         fRealStats[FP_SUBNORMAL]      = 0;
         fRealStats[CAST_INT_OVERFLOW] = 0;
+        
+        fProfile = (TRACE == 8) ? new FBCProfile<REAL>() : nullptr;
     }
 
     virtual ~FBCInterpreter()
@@ -4711,7 +4766,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         }
         if (TRACE > 0) {
             printStats();
+            printProfile();
         }
+        delete fProfile;
     }
 
     void dumpMemory(FBCBlockInstruction<REAL>* block, const std::string& name, const std::string& filename)
@@ -0,0 +1,404 @@
+/************************************************************************
+ ************************************************************************
+    FAUST compiler
+    Copyright (C) 2022 GRAME, Centre National de Creation Musicale
+    ---------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ ************************************************************************
+ ************************************************************************/
+
+#ifndef _FBC_PROFILE_H
+#define _FBC_PROFILE_H
+
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define FBC_PROFILE_UNIT "cycles"
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define FBC_PROFILE_UNIT "cycles"
+#else
+#include <chrono>
+#define FBC_PROFILE_UNIT "ns"
+#endif
+
+#include "interpreter_bytecode.hh"
+
+// Number of lines in each part of the report
+#define PROFILE_TOP_SIZE 20
+
+/*
+ Names of the FIR variables, indexed by their heap offset.
+ They are collected before the bytecode optimization, which does not keep them.
+ */
+struct FBCHeapNames {
+    std::map<int, std::string> fReal;
+    std::map<int, std::string> fInt;
+
+    // Whether the heap operands of 'opcode' are in the real heap
+    static bool isRealHeap(FBCInstruction::Opcode opcode)
+    {
+        if (opcode == FBCInstruction::kCastRealHeap) return false;
+        if (opcode == FBCInstruction::kCastIntHeap) return true;
+        const std::string& name = gFBCInstructionTable[opcode];
+        if (name.find("Real") != std::string::npos) return true;
+        if (name.find("Int") != std::string::npos) return false;
+        // 'abs', 'min' and 'max' have int versions, the 'f' ones are real
+        for (const auto& prefix : {"kAbs", "kMax", "kMin"}) {
+            size_t size = strlen(prefix);
+            if (name.compare(0, size, prefix) == 0) return name[size] == 'f';
+        }
+        return true;
+    }
+
+    // Whether fOffset1 of 'opcode' is a heap offset
+    static bool isHeapOffset1(FBCInstruction::Opcode opcode)
+    {
+        const std::string& name = gFBCInstructionTable[opcode];
+        return (opcode >= FBCInstruction::kLoadReal) && (opcode < FBCInstruction::kLoop)
+            && (opcode != FBCInstruction::kLoadSoundFieldInt) && (opcode != FBCInstruction::kLoadSoundFieldReal)
+            && (opcode != FBCInstruction::kLoadInput) && (opcode != FBCInstruction::kStoreOutput)
+            && (opcode != FBCInstruction::kBitcastInt) && (opcode != FBCInstruction::kBitcastReal)
+            && ((opcode <= FBCInstruction::kStoreOutput) || (name.find("Heap") != std::string::npos)
+                || (name.find("Value") != std::string::npos && name.find("StackValue") == std::string::npos)
+                || (name.size() > 5 && name.compare(name.size() - 5, 5, "Stack") == 0));
+    }
+
+    // Whether fOffset2 of 'opcode' is a heap offset
+    static bool isHeapOffset2(FBCInstruction::Opcode opcode)
+    {
+        const std::string& name = gFBCInstructionTable[opcode];
+        return (opcode == FBCInstruction::kMoveReal) || (opcode == FBCInstruction::kMoveInt)
+            || (opcode == FBCInstruction::kPairMoveReal) || (opcode == FBCInstruction::kPairMoveInt)
+            || ((opcode != FBCInstruction::kCastRealHeap) && (opcode != FBCInstruction::kCastIntHeap)
+                && (name.find("Heap") != std::string::npos));
+    }
+
+    template <class REAL>
+    void collect(FBCBlockInstruction<REAL>* block)
+    {
+        if (!block) return;
+        for (const auto& inst : block->fInstructions) {
+            if (inst->fName != "" && inst->fOffset1 >= 0 && isHeapOffset1(inst->fOpcode)) {
+                if (isRealHeap(inst->fOpcode)) {
+                    fReal[inst->fOffset1] = inst->fName;
+                } else {
+                    fInt[inst->fOffset1] = inst->fName;
+                }
+            }
+            collect(inst->getBranch1());
+            collect(inst->getBranch2());
+        }
+    }
+
+    std::string getName(bool real, int offset)
+    {
+        std::map<int, std::string>& names = (real) ? fReal : fInt;
+        // Array elements are accessed at 'base + index' by the optimized code
+        auto it = names.upper_bound(offset);
+        if (it == names.begin()) return ((real) ? "real[" : "int[") + std::to_string(offset) + "]";
+        it--;
+        return (it->first == offset) ? it->second : it->second + "[" + std::to_string(offset - it->first) + "]";
+    }
+
+    // The FIR variables (or audio channels) accessed by 'inst'
+    template <class REAL>
+    void getVariables(FBCBasicInstruction<REAL>* inst, std::vector<std::string>& variables)
+    {
+        if (inst->fOpcode == FBCInstruction::kLoadInput) {
+            variables.push_back("input" + std::to_string(inst->fOffset1));
+        } else if (inst->fOpcode == FBCInstruction::kStoreOutput) {
+            variables.push_back("output" + std::to_string(inst->fOffset1));
+        } else if (inst->fOffset1 >= 0 && isHeapOffset1(inst->fOpcode)) {
+            bool real = isRealHeap(inst->fOpcode);
+            variables.push_back((inst->fName != "") ? inst->fName : getName(real, inst->fOffset1));
+            if (inst->fOffset2 >= 0 && isHeapOffset2(inst->fOpcode)) {
+                variables.push_back(getName(real, inst->fOffset2));
+            }
+        }
+    }
+};
+
+/*
+ Interpreter profile (trace mode 8): execution count of each instruction, and cost of a sample of the executed
+ instructions measured with the cycle counter. The cost of an instruction is estimated with its count and
+ the mean cost of its samples (or of the samples of its opcode when it has none).
+
+ The report gives the cost of each block, of each opcode, and of the hottest instruction sequences,
+ a sequence being the instructions of a block up to a store (so roughly a FIR statement).
+ */
+template <class REAL>
+struct FBCProfile {
+    struct Counter {
+        int64_t fCount   = 0;
+        int64_t fSamples = 0;
+        int64_t fCycles  = 0;
+    };
+
+    struct Sequence {
+        std::string              fBlock;
+        int                      fFirst;
+        int                      fLast;
+        int64_t                  fCount;
+        double                   fCycles;
+        std::vector<std::string> fOpcodes;
+        std::vector<std::string> fVariables;
+    };
+
+    std::unordered_map<FBCBasicInstruction<REAL>*, Counter> fCounters;
+
+    Counter* fSampled;
+    int64_t  fSampleStart;
+    int      fCountdown;
+    uint32_t fRandom;
+    int64_t  fOverhead;  // Cost of reading the counter, removed from the samples
+
+    static inline int64_t getCycles()
+    {
+    #if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        return int64_t(__rdtsc());
+    #else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    #endif
+    }
+
+    FBCProfile() : fSampled(nullptr), fSampleStart(0), fCountdown(1), fRandom(1)
+    {
+        fOverhead = INT64_MAX;
+        for (int i = 0; i < 64; i++) {
+            int64_t start = getCycles();
+            fOverhead = std::min(fOverhead, getCycles() - start);
+        }
+    }
+
+    inline void closeSample()
+    {
+        if (fSampled) {
+            fSampled->fCycles += std::max(int64_t(0), getCycles() - fSampleStart - fOverhead);
+            fSampled->fSamples++;
+            fSampled = nullptr;
+        }
+    }
+
+    // Called before the execution of each instruction
+    inline void enter(FBCBasicInstruction<REAL>* inst)
+    {
+        closeSample();
+        Counter& counter = fCounters[inst];
+        counter.fCount++;
+        if (--fCountdown == 0) {
+            // Pseudo random period (64 on average), to avoid sampling the same instructions of a loop
+            fRandom    = fRandom * 1103515245 + 12345;
+            fCountdown = 1 + ((fRandom >> 16) & 127);
+            fSampled   = &counter;
+            fSampleStart = getCycles();
+        }
+    }
+
+    // Called at the end of each block
+    inline void leave() { closeSample(); }
+
+    void estimateOpcodes(std::map<int, std::pair<int64_t, int64_t>>& samples)
+    {
+        for (const auto& it : fCounters) {
+            samples[it.first->fOpcode].first += it.second.fSamples;
+            samples[it.first->fOpcode].second += it.second.fCycles;
+        }
+    }
+
+    double estimate(FBCBasicInstruction<REAL>* inst, std::map<int, std::pair<int64_t, int64_t>>& opcodes)
+    {
+        auto it = fCounters.find(inst);
+        if (it == fCounters.end()) return 0.;
+        const Counter& counter = it->second;
+        if (counter.fSamples > 0) {
+            return double(counter.fCount) * double(counter.fCycles) / double(counter.fSamples);
+        }
+        const std::pair<int64_t, int64_t>& opcode = opcodes[inst->fOpcode];
+        return (opcode.first > 0) ? double(counter.fCount) * double(opcode.second) / double(opcode.first) : 0.;
+    }
+
+    int64_t getCount(FBCBasicInstruction<REAL>* inst)
+    {
+        auto it = fCounters.find(inst);
+        return (it != fCounters.end()) ? it->second.fCount : 0;
+    }
+
+    static bool isStore(FBCInstruction::Opcode opcode)
+    {
+        const std::string& name = gFBCInstructionTable[opcode];
+        return (name.compare(0, 6, "kStore") == 0) || (name.compare(0, 11, "kBlockStore") == 0)
+            || (name.compare(0, 5, "kMove") == 0) || (name.compare(0, 9, "kPairMove") == 0)
+            || (name.compare(0, 14, "kBlockPairMove") == 0) || (name.compare(0, 11, "kBlockShift") == 0);
+    }
+
+    // Walk 'block' and its sub-blocks, accumulating block costs and instruction sequences
+    void analyseBlock(FBCBlockInstruction<REAL>* block, const std::string& name, FBCHeapNames& names,
+                      std::map<int, std::pair<int64_t, int64_t>>& opcodes,
+                      std::vector<std::pair<std::string, std::pair<int64_t, double>>>& blocks,
+                      std::vector<Sequence>& sequences)
+    {
+        if (!block) return;
+        int64_t  block_count  = 0;
+        double   block_cycles = 0.;
+        Sequence seq;
+        seq.fFirst = -1;
+
+        int index = 0;
+        for (const auto& inst : block->fInstructions) {
+            int64_t count  = getCount(inst);
+            double  cycles = estimate(inst, opcodes);
+            block_count += count;
+            block_cycles += cycles;
+
+            if (seq.fFirst < 0) {
+                seq.fBlock  = name;
+                seq.fFirst  = index;
+                seq.fCount  = count;
+                seq.fCycles = 0.;
+                seq.fOpcodes.clear();
+                seq.fVariables.clear();
+            }
+            seq.fLast = index;
+            seq.fCount = std::max(seq.fCount, count);
+            seq.fCycles += cycles;
+            seq.fOpcodes.push_back(gFBCInstructionTable[inst->fOpcode].substr(1));
+            std::vector<std::string> variables;
+            names.getVariables(inst, variables);
+            for (const auto& var : variables) {
+                if (std::find(seq.fVariables.begin(), seq.fVariables.end(), var) == seq.fVariables.end()) {
+                    seq.fVariables.push_back(var);
+                }
+            }
+
+            bool branch = inst->getBranch1() || inst->getBranch2();
+            if (isStore(inst->fOpcode) || branch || inst->fOpcode == FBCInstruction::kReturn
+                || inst->fOpcode == FBCInstruction::kCondBranch) {
+                if (seq.fCycles > 0.) sequences.push_back(seq);
+                seq.fFirst = -1;
+            }
+
+            // Sub-blocks
+            if (branch) {
+                std::string sub_name = name + "/" + gFBCInstructionTable[inst->fOpcode].substr(1) + std::to_string(index);
+                if (inst->fOpcode == FBCInstruction::kLoop) {
+                    analyseBlock(inst->getBranch1(), sub_name + ".init", names, opcodes, blocks, sequences);
+                    analyseBlock(inst->getBranch2(), sub_name + ".body", names, opcodes, blocks, sequences);
+                } else {
+                    analyseBlock(inst->getBranch1(), sub_name + ".then", names, opcodes, blocks, sequences);
+                    analyseBlock(inst->getBranch2(), sub_name + ".else", names, opcodes, blocks, sequences);
+                }
+            }
+            index++;
+        }
+        if (seq.fFirst >= 0 && seq.fCycles > 0.) sequences.push_back(seq);
+        if (block_count > 0) {
+            blocks.push_back(std::make_pair(name, std::make_pair(block_count, block_cycles)));
+        }
+    }
+
+    static std::string percent(double value, double total)
+    {
+        std::stringstream str;
+        str << std::fixed << std::setprecision(1) << ((total > 0.) ? (100. * value / total) : 0.) << "%";
+        return str.str();
+    }
+
+    void print(std::ostream* out, const std::vector<std::pair<std::string, FBCBlockInstruction<REAL>*>>& roots,
+               FBCHeapNames& names)
+    {
+        std::map<int, std::pair<int64_t, int64_t>> opcodes;
+        estimateOpcodes(opcodes);
+
+        std::vector<std::pair<std::string, std::pair<int64_t, double>>> blocks;
+        std::vector<Sequence>                                         sequences;
+        for (const auto& root : roots) {
+            analyseBlock(root.second, root.first, names, opcodes, blocks, sequences);
+        }
+
+        int64_t total_count   = 0;
+        int64_t total_samples = 0;
+        double  total_cycles  = 0.;
+        std::map<int, std::pair<int64_t, double>> opcode_costs;
+        for (const auto& it : fCounters) {
+            double cycles = estimate(it.first, opcodes);
+            total_count += it.second.fCount;
+            total_samples += it.second.fSamples;
+            total_cycles += cycles;
+            opcode_costs[it.first->fOpcode].first += it.second.fCount;
+            opcode_costs[it.first->fOpcode].second += cycles;
+        }
+
+        *out << std::fixed << std::setprecision(1);
+        *out << "-------------------------------" << std::endl;
+        *out << "Interpreter profile" << std::endl;
+        *out << "Executed instructions: " << total_count << ", estimated cost: " << int64_t(total_cycles) << " "
+             << FBC_PROFILE_UNIT << " (" << total_samples << " samples, counter overhead " << fOverhead << " "
+             << FBC_PROFILE_UNIT << " removed)" << std::endl;
+
+        *out << "-------- Blocks --------" << std::endl;
+        std::sort(blocks.begin(), blocks.end(),
+                  [](const std::pair<std::string, std::pair<int64_t, double>>& a,
+                     const std::pair<std::string, std::pair<int64_t, double>>& b) { return a.second.second > b.second.second; });
+        for (size_t i = 0; i < blocks.size() && i < PROFILE_TOP_SIZE; i++) {
+            *out << std::setw(7) << percent(blocks[i].second.second, total_cycles) << "  " << blocks[i].first
+                 << " : " << blocks[i].second.first << " instructions, " << int64_t(blocks[i].second.second) << " "
+                 << FBC_PROFILE_UNIT << std::endl;
+        }
+
+        *out << "-------- Opcodes --------" << std::endl;
+        std::vector<std::pair<int, std::pair<int64_t, double>>> sorted_opcodes(opcode_costs.begin(), opcode_costs.end());
+        std::sort(sorted_opcodes.begin(), sorted_opcodes.end(),
+                  [](const std::pair<int, std::pair<int64_t, double>>& a,
+                     const std::pair<int, std::pair<int64_t, double>>& b) { return a.second.second > b.second.second; });
+        for (size_t i = 0; i < sorted_opcodes.size() && i < PROFILE_TOP_SIZE; i++) {
+            const std::pair<int64_t, double>& cost = sorted_opcodes[i].second;
+            *out << std::setw(7) << percent(cost.second, total_cycles) << "  "
+                 << std::left << std::setw(22) << gFBCInstructionTable[sorted_opcodes[i].first] << std::right
+                 << " : " << cost.first << " executions, "
+                 << ((cost.first > 0) ? cost.second / double(cost.first) : 0.) << " " << FBC_PROFILE_UNIT
+                 << " each" << std::endl;
+        }
+
+        *out << "-------- Hottest instruction sequences --------" << std::endl;
+        std::sort(sequences.begin(), sequences.end(),
+                  [](const Sequence& a, const Sequence& b) { return a.fCycles > b.fCycles; });
+        for (size_t i = 0; i < sequences.size() && i < PROFILE_TOP_SIZE; i++) {
+            const Sequence& seq = sequences[i];
+            *out << std::setw(7) << percent(seq.fCycles, total_cycles) << "  " << seq.fBlock << " ["
+                 << seq.fFirst << ".." << seq.fLast << "] : " << seq.fCount << " executions, "
+                 << ((seq.fCount > 0) ? seq.fCycles / double(seq.fCount) : 0.) << " " << FBC_PROFILE_UNIT
+                 << " each" << std::endl;
+            *out << "         variables:";
+            for (const auto& var : seq.fVariables) *out << " " << var;
+            *out << std::endl << "         code:";
+            for (const auto& op : seq.fOpcodes) *out << " " << op;
+            *out << std::endl;
+        }
+        *out << "-------------------------------" << std::endl;
+    }
+};
+
+#endif
@@ -193,8 +193,16 @@ void interpreter_dsp_factory_aux<REAL, TRACE>::optimize()
 {
     if (!fOptimized) {
         fOptimized = true;
-        // Bytecode optimization
-        if (TRACE == 0) {
+        // Bytecode optimization (the profile mode measures the optimized code, keeping the variable names first)
+        if (TRACE == 8) {
+            fHeapNames.collect(fStaticInitBlock);
+            fHeapNames.collect(fInitBlock);
+            fHeapNames.collect(fResetUIBlock);
+            fHeapNames.collect(fClearBlock);
+            fHeapNames.collect(fComputeBlock);
+            fHeapNames.collect(fComputeDSPBlock);
+        }
+        if (TRACE == 0 || TRACE == 8) {
     #ifndef MACHINE
             fStaticInitBlock = FBCInstructionOptimizer<REAL>::optimizeBlock(fStaticInitBlock, 1, fOptLevel);
             fInitBlock       = FBCInstructionOptimizer<REAL>::optimizeBlock(fInitBlock, 1, fOptLevel);
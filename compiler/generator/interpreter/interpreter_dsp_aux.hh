@@ -75,6 +75,8 @@ struct interpreter_dsp_factory_aux : public dsp_factory_imp {
     FBCBlockInstruction<REAL>*              fComputeBlock;
     FBCBlockInstruction<REAL>*              fComputeDSPBlock;
 
+    FBCHeapNames fHeapNames;  // Only used in profile mode (TRACE = 8)
+
     interpreter_dsp_factory_aux(const std::string& name, const std::string& compile_options, const std::string& sha_key,
                                 int version_num, int inputs, int outputs, int int_heap_size, int real_heap_size,
                                 int sr_offset, int count_offset, int iota_offset, int opt_level,
@@ -697,7 +699,7 @@ class interpreter_dsp_aux : public interpreter_dsp_base {
             std::cout << "======== DSP is not initialized ! ========" << std::endl;
         } else {
             
-            if (TRACE > 0) {
+            if (TRACE > 0 && TRACE != 8) {
                 std::cout << "------------------------" << std::endl;
                 std::cout << "compute " << count << std::endl;
             }
@@ -822,6 +824,13 @@ class LIBFAUST_API interpreter_dsp : public dsp {
         : fFactory(factory), fDSP(dsp)
     {
     }
+    interpreter_dsp(interpreter_dsp_factory* factory, interpreter_dsp_aux<float, 8>* dsp) : fFactory(factory), fDSP(dsp)
+    {
+    }
+    interpreter_dsp(interpreter_dsp_factory* factory, interpreter_dsp_aux<double, 8>* dsp)
+        : fFactory(factory), fDSP(dsp)
+    {
+    }
 
     virtual ~interpreter_dsp();
 
@@ -54,6 +54,14 @@ LLVMCodeContainer::LLVMCodeContainer(const string& name, int numInputs, int numO
     LLVMContext* context = new LLVMContext();
     Module* module = new Module(gGlobal->printCompilationOptions1() + ", v" + string(FAUSTVERSION), *context);
     
+    // Optimization pipeline knobs, read back when the module is optimized (possibly after being saved as bitcode or IR)
+    if (gGlobal->gLLVMInlineThreshold >= 0) {
+        module->addModuleFlag(Module::Warning, "faust-inline-threshold", gGlobal->gLLVMInlineThreshold);
+    }
+    if (gGlobal->gLLVMSLP) {
+        module->addModuleFlag(Module::Warning, "faust-slp-vectorize", 1);
+    }
+    
     init(name, numInputs, numOutputs, module, context);
 }
 
@@ -239,6 +247,17 @@ dsp_factory_base* LLVMCodeContainer::produceFactory()
     // Compute
     generateCompute();
 
+    // Initialization functions are kept unoptimized (at IR and machine code levels), so that JIT compilation time is spent on 'compute'
+    if (gGlobal->gLLVMFastInit) {
+        for (const auto& fun : {"classInit", "instanceClear", "instanceConstants", "allocate", "destroy", "getJSON"}) {
+            Function* function = fModule->getFunction(fun + fKlassName);
+            if (function) {
+                function->addFnAttr(Attribute::OptimizeNone);
+                function->addFnAttr(Attribute::NoInline);
+            }
+        }
+    }
+
     // Link LLVM modules defined in 'ffunction'
     set<string> S;
     collectLibrary(S);
@@ -191,19 +191,20 @@ void llvm_dsp_factory_aux::LLVMFatalErrorHandler(const char* reason)
 
 void llvm_dsp_factory_aux::init(const string& type_name, const string& dsp_name)
 {
-    fJIT               = nullptr;
-    fAllocate          = nullptr;
-    fDestroy           = nullptr;
-    fInstanceConstants = nullptr;
-    fInstanceClear     = nullptr;
-    fClassInit         = nullptr;
-    fCompute           = nullptr;
-    fClassName         = "mydsp";
-    fName              = dsp_name;
-    fTypeName          = type_name;
-    fExpandedDSP       = "";
-    fOptLevel          = 0;
-    fTarget            = "";
+    fJIT                 = nullptr;
+    fAllocate            = nullptr;
+    fDestroy             = nullptr;
+    fInstanceConstants   = nullptr;
+    fInstanceClear       = nullptr;
+    fClassInit           = nullptr;
+    fCompute             = nullptr;
+    fClassInitSampleRate = -1;
+    fClassName           = "mydsp";
+    fName                = dsp_name;
+    fTypeName            = type_name;
+    fExpandedDSP         = "";
+    fOptLevel            = 0;
+    fTarget              = "";
 
     // To keep Debug functions in generated code
 #if 0
@@ -238,12 +239,16 @@ bool llvm_dsp_factory_aux::initJIT(string& error_msg)
     }
 
     fJIT->setObjectCache(fObjectCache);
-    fJIT->finalizeObject();
     return initJITAux();
 }
 
 bool llvm_dsp_factory_aux::initJITAux()
 {
+    // Generate (or restore from the object cache) and link the machine code
+    startTiming("finalizeObject");
+    fJIT->finalizeObject();
+    endTiming("finalizeObject");
+    
     // Run static constructors.
     fJIT->runStaticConstructorsDestructors(false);
     fJIT->DisableLazyCompilation(true);
@@ -379,7 +384,13 @@ void llvm_dsp::init(int sample_rate)
 
 void llvm_dsp::classInit(int sample_rate)
 {
-    fFactory->getFactory()->fClassInit(sample_rate);
+    llvm_dsp_factory_aux* factory = fFactory->getFactory();
+    TLock                 lock(&factory->fClassInitLock);
+    // With a custom memory manager, tables are allocated in classInit so it cannot be skipped
+    if (factory->getMemoryManager() || factory->fClassInitSampleRate != sample_rate) {
+        factory->fClassInit(sample_rate);
+        factory->fClassInitSampleRate = sample_rate;
+    }
 }
 
 void llvm_dsp::instanceInit(int sample_rate)
@@ -598,6 +609,13 @@ LIBFAUST_API bool writeDSPFactoryToObjectcodeFile(llvm_dsp_factory* factory, con
     return (factory) ? factory->writeDSPFactoryToObjectcodeFile(object_code_path, target) : false;
 }
 
+LIBFAUST_API bool writeDSPFactoryToPICObjectcodeFile(llvm_dsp_factory* factory, const string& object_code_path,
+                                               const string& target)
+{
+    LOCK_API
+    return (factory) ? factory->writeDSPFactoryToObjectcodeFile(object_code_path, target, true) : false;
+}
+
 // Instance
 LIBFAUST_API llvm_dsp* llvm_dsp_factory::createDSPInstance()
 {
@@ -22,6 +22,7 @@
 #ifndef LLVM_DSP_AUX_H
 #define LLVM_DSP_AUX_H
 
+#include <atomic>
 #include <map>
 #include <string>
 #include <utility>
@@ -35,6 +36,7 @@
 
 #include "dsp_aux.hh"
 #include "dsp_factory.hh"
+#include "TMutex.h"
 #include "smartpointer.h"
 #include "timing.hh"
 
@@ -167,6 +169,11 @@ class llvm_dsp_factory_aux : public dsp_factory_imp {
     classInitFun     fClassInit;
     computeFun       fCompute;
     getJSONFun       fGetJSON;
+    
+    // Static tables are module globals shared by all instances: only fill them again if the sample rate changes.
+    // Instances can be initialized from several threads, so the check and classInit are done under fClassInitLock
+    std::atomic<int> fClassInitSampleRate;
+    TLockAble        fClassInitLock;
 
     uint64_t loadOptimize(const std::string& function);
 
@@ -220,7 +227,7 @@ class llvm_dsp_factory_aux : public dsp_factory_imp {
     virtual bool writeDSPFactoryToMachineFile(const std::string& machine_code_path, const std::string& target);
 
     // Object
-    virtual bool writeDSPFactoryToObjectcodeFile(const std::string& object_code_path, const std::string& target)
+    virtual bool writeDSPFactoryToObjectcodeFile(const std::string& object_code_path, const std::string& target, bool pic)
     {
         return false;
     }
@@ -310,9 +317,9 @@ class LIBFAUST_API llvm_dsp_factory : public dsp_factory, public faust_smartable
         return fFactory->writeDSPFactoryToMachineFile(machine_code_path, target);
     }
 
-    bool writeDSPFactoryToObjectcodeFile(const std::string& object_code_path, const std::string& target)
+    bool writeDSPFactoryToObjectcodeFile(const std::string& object_code_path, const std::string& target, bool pic = false)
     {
-        return fFactory->writeDSPFactoryToObjectcodeFile(object_code_path, target);
+        return fFactory->writeDSPFactoryToObjectcodeFile(object_code_path, target, pic);
     }
 
     llvm_dsp_factory_aux* getFactory() { return fFactory; }
@@ -67,6 +67,8 @@
 // Disappears in LLVM 15
 #if LLVM_VERSION_MAJOR >= 14
 #include <llvm/MC/TargetRegistry.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Passes/StandardInstrumentations.h>
 #else
 #include <llvm/Support/TargetRegistry.h>
 #endif
@@ -188,12 +190,59 @@ bool llvm_dynamic_dsp_factory_aux::writeDSPFactoryToIRFile(const string& ir_code
     return true;
 }
 
+// Pipeline knobs set with -lit and -lslp are kept as module flags
+static int getModuleFlagValue(Module* module, const string& name, int def)
+{
+    ConstantInt* flag = mdconst::extract_or_null<ConstantInt>(module->getModuleFlag(name));
+    return (flag) ? int(flag->getSExtValue()) : def;
+}
+
+#if LLVM_VERSION_MAJOR >= 14
+/// RunOptimizationPipeline - Optimizes the module with the new pass manager
+/// default pipeline, at the selected optimization level, OptLevel.
+static void RunOptimizationPipeline(Module* module, TargetMachine* tm, unsigned OptLevel)
+{
+    PipelineTuningOptions tuning;
+    tuning.LoopUnrolling = (OptLevel > 0);
+    // Loops marked with 'llvm.loop.vectorize.enable' are always vectorized
+    tuning.LoopVectorization = (OptLevel > 3);
+    tuning.LoopInterleaving  = (OptLevel > 3);
+    tuning.SLPVectorization  = (OptLevel > 3) || getModuleFlagValue(module, "faust-slp-vectorize", 0);
+#if LLVM_VERSION_MAJOR >= 15
+    // -lit is rejected by the compiler with LLVM 14 (no inliner threshold in PipelineTuningOptions)
+    tuning.InlinerThreshold  = getModuleFlagValue(module, "faust-inline-threshold", -1);
+#endif
+
+    LoopAnalysisManager     LAM;
+    FunctionAnalysisManager FAM;
+    CGSCCAnalysisManager    CGAM;
+    ModuleAnalysisManager   MAM;
+
+    // Standard instrumentations are needed for 'optnone' functions to be skipped
+    PassInstrumentationCallbacks PIC;
+    StandardInstrumentations SI(false);
+    SI.registerCallbacks(PIC, &FAM);
+
+    PassBuilder PB(tm, tuning, None, &PIC);
+    PB.registerModuleAnalyses(MAM);
+    PB.registerCGSCCAnalyses(CGAM);
+    PB.registerFunctionAnalyses(FAM);
+    PB.registerLoopAnalyses(LAM);
+    PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+
+    OptimizationLevel level = (OptLevel == 1) ? OptimizationLevel::O1
+                                              : ((OptLevel == 2) ? OptimizationLevel::O2 : OptimizationLevel::O3);
+    ModulePassManager MPM = PB.buildPerModuleDefaultPipeline(level);
+    MPM.addPass(VerifierPass());
+    MPM.run(*module, MAM);
+}
+#else
 /// AddOptimizationPasses - This routine adds optimization passes
 /// based on selected optimization level, OptLevel. This routine
 /// duplicates llvm-gcc behaviour.
 ///
 /// OptLevel - Optimization Level
-static void AddOptimizationPasses(PassManagerBase& MPM, FUNCTION_PASS_MANAGER& FPM, unsigned OptLevel,
+static void AddOptimizationPasses(Module* module, PassManagerBase& MPM, FUNCTION_PASS_MANAGER& FPM, unsigned OptLevel,
                                   unsigned SizeLevel)
 {
     FPM.add(createVerifierPass());  // Verify that input is correct
@@ -212,6 +261,7 @@ static void AddOptimizationPasses(PassManagerBase& MPM, FUNCTION_PASS_MANAGER& F
         if (OptLevel > 2) {
             Threshold = 275;
         }
+        Threshold       = getModuleFlagValue(module, "faust-inline-threshold", Threshold);
         Builder.Inliner = createFunctionInliningPass(Threshold);
     } else {
         Builder.Inliner = createAlwaysInlinerLegacyPass();
@@ -224,10 +274,12 @@ static void AddOptimizationPasses(PassManagerBase& MPM, FUNCTION_PASS_MANAGER& F
         Builder.LoopVectorize = true;
         Builder.SLPVectorize  = true;
     }
+    Builder.SLPVectorize |= bool(getModuleFlagValue(module, "faust-slp-vectorize", 0));
 
     Builder.populateFunctionPassManager(FPM);
     Builder.populateModulePassManager(MPM);
 }
+#endif
 
 bool llvm_dynamic_dsp_factory_aux::initJIT(string& error_msg)
 {
@@ -281,6 +333,18 @@ bool llvm_dynamic_dsp_factory_aux::initJIT(string& error_msg)
     fModule->setTargetTriple(triple);
 
     builder.setMCPU((cpu == "") ? sys::getHostCPUName() : StringRef(cpu));
+    
+    // For the host, use the actually available features (like AVX) instead of the ones deduced from the CPU name
+    if (cpu == "") {
+        StringMap<bool> host_features;
+        if (sys::getHostCPUFeatures(host_features)) {
+            vector<string> attrs;
+            for (const auto& it : host_features) {
+                attrs.push_back((it.second ? "+" : "-") + it.first().str());
+            }
+            builder.setMAttrs(attrs);
+        }
+    }
     TargetOptions targetOptions;
 
     // -fastmath is activated at IR level, and has to be setup at JIT level also
@@ -323,6 +387,28 @@ bool llvm_dynamic_dsp_factory_aux::initJIT(string& error_msg)
     int optlevel = getOptlevel();
 
     if ((optlevel == -1) || (fOptLevel > optlevel)) {
+#if LLVM_VERSION_MAJOR >= 14
+        fModule->setDataLayout(fJIT->getDataLayout());
+        
+        if ((debug_var != "") && (debug_var.find("FAUST_LLVM1") != string::npos)) {
+            dumpLLVM(fModule);
+        }
+        
+        startTiming("optimizeModule");
+        if (fOptLevel > 0) {
+            RunOptimizationPipeline(fModule, tm, fOptLevel);
+        } else if (verifyModule(*fModule, &errs())) {
+            endTiming("optimizeModule");
+            endTiming("initJIT");
+            error_msg = "ERROR : invalid LLVM module\n";
+            return false;
+        }
+        endTiming("optimizeModule");
+        
+        if ((debug_var != "") && (debug_var.find("FAUST_LLVM2") != string::npos)) {
+            dumpLLVM(fModule);
+        }
+#else
         PASS_MANAGER          pm;
         FUNCTION_PASS_MANAGER fpm(fModule);
 
@@ -336,7 +422,7 @@ bool llvm_dynamic_dsp_factory_aux::initJIT(string& error_msg)
         pm.add(createTargetTransformInfoWrapperPass(tm->getTargetIRAnalysis()));
 
         if (fOptLevel > 0) {
-            AddOptimizationPasses(pm, fpm, fOptLevel, 0);
+            AddOptimizationPasses(fModule, pm, fpm, fOptLevel, 0);
         }
 
         if ((debug_var != "") && (debug_var.find("FAUST_LLVM1") != string::npos)) {
@@ -359,10 +445,13 @@ bool llvm_dynamic_dsp_factory_aux::initJIT(string& error_msg)
         }
 
         // Now that we have all of the passes ready, run them.
+        startTiming("optimizeModule");
         pm.run(*fModule);
+        endTiming("optimizeModule");
         if ((debug_var != "") && (debug_var.find("FAUST_LLVM2") != string::npos)) {
             dumpLLVM(fModule);
         }
+#endif
     }
 
     fObjectCache = new FaustObjectCache();
@@ -405,7 +494,7 @@ static llvm_dsp_factory* readDSPFactoryFromBitcodeAux(MEMORY_BUFFER buffer, cons
 }
 
 // Object code <==> file (taken from toy.cpp)
-bool llvm_dynamic_dsp_factory_aux::writeDSPFactoryToObjectcodeFileAux(const string& object_code_path)
+bool llvm_dynamic_dsp_factory_aux::writeDSPFactoryToObjectcodeFileAux(const string& object_code_path, bool pic)
 {
     auto TargetTriple = sys::getDefaultTargetTriple();
     fModule->setTargetTriple(TargetTriple);
@@ -423,7 +512,8 @@ bool llvm_dynamic_dsp_factory_aux::writeDSPFactoryToObjectcodeFileAux(const stri
     StringRef CPU = sys::getHostCPUName();
     string Features;
     TargetOptions opt;
-    auto RM = Optional<Reloc::Model>();
+    // Position independent code when the object code is to be linked in a shared library
+    auto RM = (pic) ? Optional<Reloc::Model>(Reloc::PIC_) : Optional<Reloc::Model>();
     auto TheTargetMachine = Target->createTargetMachine(TargetTriple, CPU, Features, opt, RM);
     fModule->setDataLayout(TheTargetMachine->createDataLayout());
 
@@ -453,13 +543,13 @@ bool llvm_dynamic_dsp_factory_aux::writeDSPFactoryToObjectcodeFileAux(const stri
 
 // Object code <==> file
 bool llvm_dynamic_dsp_factory_aux::writeDSPFactoryToObjectcodeFile(const string& object_code_path,
-                                                                   const string& target)
+                                                                   const string& target, bool pic)
 {
     if (target != "" && target != getTarget()) {
         // Recompilation is required
         string old_target = getTarget();
         if (crossCompile(target)) {
-            bool res = writeDSPFactoryToObjectcodeFileAux(object_code_path);
+            bool res = writeDSPFactoryToObjectcodeFileAux(object_code_path, pic);
             // Restore old target
             crossCompile(old_target);
             return res;
@@ -467,7 +557,7 @@ bool llvm_dynamic_dsp_factory_aux::writeDSPFactoryToObjectcodeFile(const string&
             return false;
         }
     } else {
-        return writeDSPFactoryToObjectcodeFileAux(object_code_path);
+        return writeDSPFactoryToObjectcodeFileAux(object_code_path, pic);
     }
 }
         
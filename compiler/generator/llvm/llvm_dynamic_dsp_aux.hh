@@ -26,7 +26,7 @@
 
 class llvm_dynamic_dsp_factory_aux : public llvm_dsp_factory_aux {
    private:
-    bool writeDSPFactoryToObjectcodeFileAux(const std::string& object_code_path);
+    bool writeDSPFactoryToObjectcodeFileAux(const std::string& object_code_path, bool pic);
 
    public:
     llvm_dynamic_dsp_factory_aux(const std::string& sha_key, llvm::Module* module, llvm::LLVMContext* context,
@@ -55,7 +55,7 @@ class llvm_dynamic_dsp_factory_aux : public llvm_dsp_factory_aux {
     virtual bool writeDSPFactoryToIRFile(const std::string& ir_code_path);
 
     // Object code
-    bool writeDSPFactoryToObjectcodeFile(const std::string& object_code_path, const std::string& target);
+    bool writeDSPFactoryToObjectcodeFile(const std::string& object_code_path, const std::string& target, bool pic);
 };
 
 LIBFAUST_API llvm_dsp_factory* createDSPFactoryFromFile(const std::string& filename, int argc, const char* argv[],
@@ -102,6 +102,10 @@ LIBFAUST_API bool writeDSPFactoryToIRFile(llvm_dsp_factory* factory, const std::
 LIBFAUST_API bool writeDSPFactoryToObjectcodeFile(llvm_dsp_factory* factory, const std::string& object_code_path,
                                                   const std::string& target);
 
+// IR ==> position independent object code
+LIBFAUST_API bool writeDSPFactoryToPICObjectcodeFile(llvm_dsp_factory* factory, const std::string& object_code_path,
+                                                     const std::string& target);
+
 #ifdef __cplusplus
 extern "C" {
 #endif
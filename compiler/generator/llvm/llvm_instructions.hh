@@ -1032,6 +1032,44 @@ class LLVMInstVisitor : public InstVisitor, public LLVMTypeHelper {
         fCurValue = nullptr;
     }
 
+    MDNode* genLoopHint(const string& name, int value)
+    {
+        LLVMContext& context = fModule->getContext();
+        Metadata*    hint[]  = {MDString::get(context, name),
+                              ConstantAsMetadata::get(ConstantInt::get(getInt32Ty(), value))};
+        return MDNode::get(context, hint);
+    }
+
+    /*
+     Self referencing 'llvm.loop' metadata with the loop hints: forced vectorization
+     (with the width and interleave count set with -lvw and -lic, or otherwise chosen
+     by the target cost model), and unroll count set with -luc.
+     */
+    MDNode* genLoopMetadata(bool vectorize)
+    {
+        LLVMContext&      context = fModule->getContext();
+        auto              temp    = MDNode::getTemporary(context, ArrayRef<Metadata*>());
+        vector<Metadata*> loop_md = {temp.get()};
+        if (vectorize) {
+            Metadata* enable[] = {MDString::get(context, "llvm.loop.vectorize.enable"),
+                                  ConstantAsMetadata::get(ConstantInt::getTrue(context))};
+            loop_md.push_back(MDNode::get(context, enable));
+            if (gGlobal->gLLVMVectorWidth > 0) {
+                loop_md.push_back(genLoopHint("llvm.loop.vectorize.width", gGlobal->gLLVMVectorWidth));
+            }
+            if (gGlobal->gLLVMInterleaveCount > 0) {
+                loop_md.push_back(genLoopHint("llvm.loop.interleave.count", gGlobal->gLLVMInterleaveCount));
+            }
+        }
+        if (gGlobal->gLLVMUnrollCount > 0) {
+            loop_md.push_back(genLoopHint("llvm.loop.unroll.count", gGlobal->gLLVMUnrollCount));
+        }
+        if (loop_md.size() == 1) return nullptr;
+        MDNode* loop_id = MDNode::getDistinct(context, loop_md);
+        loop_id->replaceOperandWith(0, loop_id);
+        return loop_id;
+    }
+
     virtual void visit(ForLoopInst* inst)
     {
         // Don't generate empty loops...
@@ -1116,7 +1154,14 @@ class LLVMInstVisitor : public InstVisitor, public LLVMTypeHelper {
             phi_node->addIncoming(next_index, current_block);
 
             // Back to start of loop
-            fBuilder->CreateBr(test_block);
+            BranchInst* back_edge = fBuilder->CreateBr(test_block);
+            
+            // Non-recursive loops of the vector mode can be vectorized, the LLVM equivalent
+            // of the '#pragma clang loop vectorize(enable)' generated by the C/C++ backends
+            MDNode* loop_id = genLoopMetadata(gGlobal->gVectorSwitch && !inst->fIsRecursive);
+            if (loop_id) {
+                back_edge->setMetadata(LLVMContext::MD_loop, loop_id);
+            }
         }
 
         // Move insertion in exit_block
@@ -165,6 +165,7 @@ enum EncodedType {
     i64 = -0x2,  // 0x7e
     f32 = -0x3,  // 0x7d
     f64 = -0x4,  // 0x7c
+    v128 = -0x5,  // 0x7b
     // elem_type
     AnyFunc = -0x10,  // 0x70
     // func_type form
@@ -271,6 +272,44 @@ enum ASTNodes {
     F64ReinterpretI64 = 0xbf
 };
 
+// SIMD128 instructions: 'SIMDPrefix' byte followed by the U32LEB encoded opcode
+enum SIMDPrefix { SIMDPrefix = 0xfd };
+
+enum SIMDOp {
+    V128Load  = 0x00,
+    V128Store = 0x0b,
+
+    F32x4Splat = 0x13,
+    F64x2Splat = 0x14,
+
+    F32x4Ceil    = 0x67,
+    F32x4Floor   = 0x68,
+    F32x4Nearest = 0x6a,
+    F64x2Ceil    = 0x74,
+    F64x2Floor   = 0x75,
+    F64x2Nearest = 0x94,
+
+    F32x4Abs  = 0xe0,
+    F32x4Neg  = 0xe1,
+    F32x4Sqrt = 0xe3,
+    F32x4Add  = 0xe4,
+    F32x4Sub  = 0xe5,
+    F32x4Mul  = 0xe6,
+    F32x4Div  = 0xe7,
+    F32x4Min  = 0xe8,
+    F32x4Max  = 0xe9,
+
+    F64x2Abs  = 0xec,
+    F64x2Neg  = 0xed,
+    F64x2Sqrt = 0xef,
+    F64x2Add  = 0xf0,
+    F64x2Sub  = 0xf1,
+    F64x2Mul  = 0xf2,
+    F64x2Div  = 0xf3,
+    F64x2Min  = 0xf4,
+    F64x2Max  = 0xf5
+};
+
 enum MemoryAccess {
     Offset           = 0x10,  // bit 4
     Alignment        = 0x80,  // bit 7
@@ -460,6 +460,8 @@ WASMVectorCodeContainer::WASMVectorCodeContainer(const string& name, int numInpu
 {
     // No array on stack, move all of them in struct
     gGlobal->gMachineMaxStackSize = -1;
+    // Vector loops 'i' variable moves by frames
+    gGlobal->gLoopVarInBytes = false;
 }
 
 void WASMVectorCodeContainer::generateCompute()
@@ -23,6 +23,7 @@
 #define _WASM_INSTRUCTIONS_H
 
 #include <string.h>
+#include <climits>
 #include <cmath>
 #include <vector>
 
@@ -640,6 +641,36 @@ struct FunAndTypeCounter : public DispatchVisitor, public WASInst {
     }
 };
 
+// Check if a value does not depend of the loop variable and of the arrays written in the loop
+struct LoopInvariantChecker : public DispatchVisitor {
+    const string&          fLoopVar;
+    const map<string, int>& fStoredArrays;
+    bool                   fInvariant;
+
+    LoopInvariantChecker(const string& loop_var, const map<string, int>& stored)
+        : fLoopVar(loop_var), fStoredArrays(stored), fInvariant(true)
+    {
+    }
+
+    virtual void visit(LoadVarInst* inst)
+    {
+        string name = inst->fAddress->getName();
+        if (name == fLoopVar || fStoredArrays.find(name) != fStoredArrays.end()) {
+            fInvariant = false;
+        }
+        DispatchVisitor::visit(inst);
+    }
+
+    virtual void visit(TeeVarInst* inst) { fInvariant = false; }
+
+    bool check(ValueInst* value)
+    {
+        fInvariant = true;
+        value->accept(this);
+        return fInvariant;
+    }
+};
+
 #define EXPORTED_FUNCTION_NUM 11
 
 class WASMInstVisitor : public DispatchVisitor, public WASInst {
@@ -1380,12 +1411,279 @@ class WASMInstVisitor : public DispatchVisitor, public WASInst {
         fTypingVisitor.visit(inst);
     }
 
+    /*
+     SIMD128 compilation of the non-recursive vector loops (-wsimd):
+     the loop has to be 'for (i = init; i < bound; i = i + 1)' and its body can only contain
+     stores of real values at unit stride indexes ('array[i + k]'). The values are built with
+     +, -, *, /, abs, sqrt, min, max, floor, ceil, rint, unit stride loads,
+     and loop invariant sub-expressions computed in scalar then splatted on all lanes.
+    */
+
+    struct SIMDLoop {
+        string           fLoopVar;
+        ValueInst*       fBound;
+        map<string, int> fStoredArrays;  // Written arrays with their constant index offset
+    };
+
+    int getSIMDOp(int scalar_op)
+    {
+        switch (scalar_op) {
+            case WasmOp::F32Abs: return BinaryConsts::F32x4Abs;
+            case WasmOp::F32Neg: return BinaryConsts::F32x4Neg;
+            case WasmOp::F32Ceil: return BinaryConsts::F32x4Ceil;
+            case WasmOp::F32Floor: return BinaryConsts::F32x4Floor;
+            case WasmOp::F32NearestInt: return BinaryConsts::F32x4Nearest;
+            case WasmOp::F32Sqrt: return BinaryConsts::F32x4Sqrt;
+            case WasmOp::F32Add: return BinaryConsts::F32x4Add;
+            case WasmOp::F32Sub: return BinaryConsts::F32x4Sub;
+            case WasmOp::F32Mul: return BinaryConsts::F32x4Mul;
+            case WasmOp::F32Div: return BinaryConsts::F32x4Div;
+            case WasmOp::F32Min: return BinaryConsts::F32x4Min;
+            case WasmOp::F32Max: return BinaryConsts::F32x4Max;
+            case WasmOp::F64Abs: return BinaryConsts::F64x2Abs;
+            case WasmOp::F64Neg: return BinaryConsts::F64x2Neg;
+            case WasmOp::F64Ceil: return BinaryConsts::F64x2Ceil;
+            case WasmOp::F64Floor: return BinaryConsts::F64x2Floor;
+            case WasmOp::F64NearestInt: return BinaryConsts::F64x2Nearest;
+            case WasmOp::F64Sqrt: return BinaryConsts::F64x2Sqrt;
+            case WasmOp::F64Add: return BinaryConsts::F64x2Add;
+            case WasmOp::F64Sub: return BinaryConsts::F64x2Sub;
+            case WasmOp::F64Mul: return BinaryConsts::F64x2Mul;
+            case WasmOp::F64Div: return BinaryConsts::F64x2Div;
+            case WasmOp::F64Min: return BinaryConsts::F64x2Min;
+            case WasmOp::F64Max: return BinaryConsts::F64x2Max;
+            default: return -1;
+        }
+    }
+
+    int getSIMDOp(BinopInst* inst)
+    {
+        if (inst->fOpcode != kAdd && inst->fOpcode != kSub && inst->fOpcode != kMul && inst->fOpcode != kDiv) {
+            return -1;
+        }
+        return getSIMDOp((gGlobal->gFloatSize == 1) ? gBinOpTable[inst->fOpcode]->fWasmFloat
+                                                    : gBinOpTable[inst->fOpcode]->fWasmDouble);
+    }
+
+    int getSIMDOp(FunCallInst* inst)
+    {
+        if (fMathLibTable.find(inst->fName) == fMathLibTable.end()) return -1;
+        MathFunDesc desc = fMathLibTable[inst->fName];
+        return (desc.fMode == MathFunDesc::Gen::kWAS) ? getSIMDOp(desc.fWasmOp) : -1;
+    }
+
+    bool isRealValue(ValueInst* value)
+    {
+        value->accept(&fTypingVisitor);
+        return isRealType(fTypingVisitor.fCurType);
+    }
+
+    // Decompose an index as 'coef * i + offset' (with a non constant 'offset' when 'dynamic' is set)
+    bool getLinearIndex(SIMDLoop& loop, ValueInst* index, int sign, int& coef, int& offset, bool& dynamic)
+    {
+        LoadVarInst*  load = dynamic_cast<LoadVarInst*>(index);
+        Int32NumInst* num  = dynamic_cast<Int32NumInst*>(index);
+        BinopInst*    binop = dynamic_cast<BinopInst*>(index);
+
+        if (num) {
+            offset += sign * num->fNum;
+            return true;
+        } else if (load && load->fAddress->getName() == loop.fLoopVar) {
+            coef += sign;
+            return true;
+        } else if (binop && (binop->fOpcode == kAdd || binop->fOpcode == kSub)) {
+            return getLinearIndex(loop, binop->fInst1, sign, coef, offset, dynamic) &&
+                   getLinearIndex(loop, binop->fInst2, (binop->fOpcode == kAdd) ? sign : -sign, coef, offset, dynamic);
+        } else if (LoopInvariantChecker(loop.fLoopVar, loop.fStoredArrays).check(index)) {
+            index->accept(&fTypingVisitor);
+            dynamic = true;
+            return isInt32Type(fTypingVisitor.fCurType);
+        } else {
+            return false;
+        }
+    }
+
+    // Unit stride access with its constant index offset (INT_MAX when the offset is not constant)
+    bool isUnitStride(SIMDLoop& loop, Address* address, int& offset)
+    {
+        IndexedAddress* indexed = dynamic_cast<IndexedAddress*>(address);
+        if (!indexed || isStructType(indexed->getName()) || startWith(indexed->getName(), "inputs") ||
+            startWith(indexed->getName(), "outputs")) {
+            return false;
+        }
+        int  coef    = 0;
+        bool dynamic = false;
+        offset       = 0;
+        if (!getLinearIndex(loop, indexed->getIndex(), 1, coef, offset, dynamic) || coef != 1) return false;
+        if (dynamic) offset = INT_MAX;
+        return true;
+    }
+
+    bool isSIMDValue(SIMDLoop& loop, ValueInst* value)
+    {
+        if (!isRealValue(value)) return false;
+
+        // Splatted loop invariant value
+        if (LoopInvariantChecker(loop.fLoopVar, loop.fStoredArrays).check(value)) return true;
+
+        LoadVarInst* load  = dynamic_cast<LoadVarInst*>(value);
+        BinopInst*   binop = dynamic_cast<BinopInst*>(value);
+        ::CastInst*  cast  = dynamic_cast<::CastInst*>(value);
+        FunCallInst* call  = dynamic_cast<FunCallInst*>(value);
+
+        if (load) {
+            int offset;
+            if (!isUnitStride(loop, load->fAddress, offset)) return false;
+            // An array written in the loop can only be read at the written index
+            auto it = loop.fStoredArrays.find(load->fAddress->getName());
+            return (it == loop.fStoredArrays.end()) || (offset != INT_MAX && it->second == offset);
+        } else if (binop) {
+            return (getSIMDOp(binop) >= 0) && isSIMDValue(loop, binop->fInst1) && isSIMDValue(loop, binop->fInst2);
+        } else if (cast) {
+            return isSIMDValue(loop, cast->fInst);
+        } else if (call) {
+            if (getSIMDOp(call) < 0) return false;
+            for (const auto& it : call->fArgs) {
+                if (!isSIMDValue(loop, it)) return false;
+            }
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    bool isSIMDLoop(ForLoopInst* inst, SIMDLoop& loop)
+    {
+        if (!gGlobal->gWASMSIMD || inst->fIsRecursive) return false;
+
+        // 'i = init' and 'i = i + 1'
+        StoreVarInst* init      = dynamic_cast<StoreVarInst*>(inst->fInit);
+        StoreVarInst* increment = dynamic_cast<StoreVarInst*>(inst->fIncrement);
+        if (!init || !increment) return false;
+        loop.fLoopVar = init->fAddress->getName();
+        if (increment->fAddress->getName() != loop.fLoopVar) return false;
+        BinopInst*    incr_value = dynamic_cast<BinopInst*>(increment->fValue);
+        LoadVarInst*  incr_var   = (incr_value) ? dynamic_cast<LoadVarInst*>(incr_value->fInst1) : nullptr;
+        Int32NumInst* incr_num   = (incr_value) ? dynamic_cast<Int32NumInst*>(incr_value->fInst2) : nullptr;
+        if (!incr_value || incr_value->fOpcode != kAdd || !incr_var || incr_var->fAddress->getName() != loop.fLoopVar ||
+            !incr_num || incr_num->fNum != 1) {
+            return false;
+        }
+
+        // 'i < bound'
+        BinopInst*   end     = dynamic_cast<BinopInst*>(inst->fEnd);
+        LoadVarInst* end_var = (end) ? dynamic_cast<LoadVarInst*>(end->fInst1) : nullptr;
+        if (!end || end->fOpcode != kLT || !end_var || end_var->fAddress->getName() != loop.fLoopVar) return false;
+        loop.fBound = end->fInst2;
+
+        // Written arrays, each one at a single index
+        for (const auto& it : inst->fCode->fCode) {
+            StoreVarInst* store = dynamic_cast<StoreVarInst*>(it);
+            int           offset;
+            if (!store || !isUnitStride(loop, store->fAddress, offset) || !isRealValue(store->fValue)) return false;
+            string name = store->fAddress->getName();
+            if (loop.fStoredArrays.find(name) != loop.fStoredArrays.end() &&
+                (offset == INT_MAX || loop.fStoredArrays[name] != offset)) {
+                return false;
+            }
+            loop.fStoredArrays[name] = offset;
+        }
+
+        if (!LoopInvariantChecker(loop.fLoopVar, loop.fStoredArrays).check(loop.fBound)) return false;
+        for (const auto& it : inst->fCode->fCode) {
+            if (!isSIMDValue(loop, static_cast<StoreVarInst*>(it)->fValue)) return false;
+        }
+        return true;
+    }
+
+    void generateSIMDOp(int op) { *fOut << int8_t(BinaryConsts::SIMDPrefix) << U32LEB(op); }
+
+    void generateSIMDValue(SIMDLoop& loop, ValueInst* value)
+    {
+        if (LoopInvariantChecker(loop.fLoopVar, loop.fStoredArrays).check(value)) {
+            value->accept(this);
+            generateSIMDOp((gGlobal->gFloatSize == 1) ? BinaryConsts::F32x4Splat : BinaryConsts::F64x2Splat);
+        } else if (LoadVarInst* load = dynamic_cast<LoadVarInst*>(value)) {
+            load->fAddress->accept(this);
+            generateSIMDOp(BinaryConsts::V128Load);
+            generateMemoryAccess();
+        } else if (BinopInst* binop = dynamic_cast<BinopInst*>(value)) {
+            generateSIMDValue(loop, binop->fInst1);
+            generateSIMDValue(loop, binop->fInst2);
+            generateSIMDOp(getSIMDOp(binop));
+        } else if (::CastInst* cast = dynamic_cast<::CastInst*>(value)) {
+            generateSIMDValue(loop, cast->fInst);
+        } else if (FunCallInst* call = dynamic_cast<FunCallInst*>(value)) {
+            for (const auto& it : call->fArgs) {
+                generateSIMDValue(loop, it);
+            }
+            generateSIMDOp(getSIMDOp(call));
+        } else {
+            faustassert(false);
+        }
+    }
+
+    void generateSIMDLoop(ForLoopInst* inst, SIMDLoop& loop)
+    {
+        faustassert(fLocalVarTable.find(loop.fLoopVar) != fLocalVarTable.end());
+        int loop_var = fLocalVarTable[loop.fLoopVar].fIndex;
+        int lanes    = 16 / gGlobal->audioSampleSize();
+
+        // Init loop counter
+        inst->fInit->accept(this);
+
+        // SIMD loop, running while 'lanes' frames are left
+        *fOut << int8_t(BinaryConsts::Block) << S32LEB(BinaryConsts::Empty);
+        *fOut << int8_t(BinaryConsts::Loop) << S32LEB(BinaryConsts::Empty);
+        *fOut << int8_t(BinaryConsts::LocalGet) << U32LEB(loop_var);
+        *fOut << int8_t(BinaryConsts::I32Const) << S32LEB(lanes);
+        *fOut << int8_t(WasmOp::I32Add);
+        loop.fBound->accept(this);
+        *fOut << int8_t(WasmOp::I32GtS);
+        *fOut << int8_t(BinaryConsts::BrIf) << U32LEB(1);
+
+        for (const auto& it : inst->fCode->fCode) {
+            StoreVarInst* store = static_cast<StoreVarInst*>(it);
+            store->fAddress->accept(this);
+            generateSIMDValue(loop, store->fValue);
+            generateSIMDOp(BinaryConsts::V128Store);
+            generateMemoryAccess();
+        }
+
+        *fOut << int8_t(BinaryConsts::LocalGet) << U32LEB(loop_var);
+        *fOut << int8_t(BinaryConsts::I32Const) << S32LEB(lanes);
+        *fOut << int8_t(WasmOp::I32Add);
+        *fOut << int8_t(BinaryConsts::LocalSet) << U32LEB(loop_var);
+        *fOut << int8_t(BinaryConsts::Br) << U32LEB(0);
+        *fOut << int8_t(BinaryConsts::End);
+        *fOut << int8_t(BinaryConsts::End);
+
+        // Scalar loop for the remaining frames (possibly none, so the test is done first)
+        *fOut << int8_t(BinaryConsts::Block) << S32LEB(BinaryConsts::Empty);
+        *fOut << int8_t(BinaryConsts::Loop) << S32LEB(BinaryConsts::Empty);
+        *fOut << int8_t(BinaryConsts::LocalGet) << U32LEB(loop_var);
+        loop.fBound->accept(this);
+        *fOut << int8_t(WasmOp::I32GeS);
+        *fOut << int8_t(BinaryConsts::BrIf) << U32LEB(1);
+        inst->fCode->accept(this);
+        inst->fIncrement->accept(this);
+        *fOut << int8_t(BinaryConsts::Br) << U32LEB(0);
+        *fOut << int8_t(BinaryConsts::End);
+        *fOut << int8_t(BinaryConsts::End);
+    }
+
     // Loop : beware: compiled loop don't work with an index of 0
     virtual void visit(ForLoopInst* inst)
     {
         // Don't generate empty loops...
         if (inst->fCode->size() == 0) return;
 
+        SIMDLoop loop;
+        if (isSIMDLoop(inst, loop)) {
+            generateSIMDLoop(inst, loop);
+            return;
+        }
+
         // Init loop counter
         inst->fInit->accept(this);
 
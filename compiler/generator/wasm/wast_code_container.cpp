@@ -458,6 +458,8 @@ WASTVectorCodeContainer::WASTVectorCodeContainer(const string& name, int numInpu
 {
     // No array on stack, move all of them in struct
     gGlobal->gMachineMaxStackSize = -1;
+    // Vector loops 'i' variable moves by frames
+    gGlobal->gLoopVarInBytes = false;
 }
 
 void WASTVectorCodeContainer::generateCompute(int n)
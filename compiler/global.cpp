@@ -146,6 +146,7 @@ global::global() : TABBER(1), gLoopDetector(1024, 400), gStackOverflowDetector(M
     gDumpNorm      = false;
     gFTZMode       = 0;
     gRangeUI       = false;
+    gHotColdStruct = false;
 
     gFloatSize = 1;
 
@@ -175,6 +176,15 @@ global::global() : TABBER(1), gLoopDetector(1024, 400), gStackOverflowDetector(M
     gComputeIOTA          = false;
     gFAUSTFLOAT2Internal  = false;
     gInPlace              = false;
+    gMultiVersioning      = false;
+    gProfileLoops         = false;
+    gLLVMVectorWidth      = 0;
+    gLLVMInterleaveCount  = 0;
+    gLLVMUnrollCount      = 0;
+    gLLVMInlineThreshold  = -1;
+    gLLVMSLP              = false;
+    gLLVMFastInit         = false;
+    gWASMSIMD             = false;
     gHasExp10             = false;
     gLoopVarInBytes       = false;
     gWaveformInDSP        = false;
@@ -495,6 +505,9 @@ void global::init()
     gMemoizedTypes          = new property<AudioType*>();
     gAllocationCount        = 0;
     gMaskDelayLineThreshold = INT_MAX;
+    gMaskDelayLineWaste     = 100;
+    gDelayLinesSize         = make_pair(0, 0);
+    gControlRateInterp      = 0;
 
     // True by default but only usable with -lang ocpp backend
     gEnableFlag = true;
@@ -665,16 +678,38 @@ void global::printCompilationOptions(stringstream& dst, bool backend)
     }
     if (gInlineArchSwitch) dst << "-i ";
     if (gInPlace) dst << "-inpl ";
+    if (gMultiVersioning) dst << "-fmv ";
+    if (gProfileLoops) dst << "-prof ";
+    if (gLLVMVectorWidth > 0) dst << "-lvw " << gLLVMVectorWidth << " ";
+    if (gLLVMInterleaveCount > 0) dst << "-lic " << gLLVMInterleaveCount << " ";
+    if (gLLVMUnrollCount > 0) dst << "-luc " << gLLVMUnrollCount << " ";
+    if (gLLVMInlineThreshold >= 0) dst << "-lit " << gLLVMInlineThreshold << " ";
+    if (gLLVMSLP) dst << "-lslp ";
+    if (gLLVMFastInit) dst << "-lfi ";
+    if (gWASMSIMD) dst << "-wsimd ";
     if (gOneSample >= 0) dst << "-os" << gOneSample << " ";
     if (gLightMode) dst << "-light ";
     if (gMemoryManager) dst << "-mem ";
     if (gComputeMix) dst << "-cm ";
     if (gRangeUI) dst << "-rui ";
+    if (gHotColdStruct) dst << "-hcs ";
     if (gMathApprox) dst << "-mapp ";
     if (gClassName != "mydsp") dst << "-cn " << gClassName << " ";
     if (gSuperClassName != "dsp") dst << "-scn " << gSuperClassName << " ";
     if (gProcessName != "process") dst << "-pn " << gProcessName << " ";
     if (gMaskDelayLineThreshold != INT_MAX) dst << "-dtl " << gMaskDelayLineThreshold << " ";
+    if (gMaskDelayLineWaste != 100) dst << "-dlw " << gMaskDelayLineWaste << " ";
+    if (gLiveOutputs.size() > 0) {
+        dst << "-lo ";
+        string sep;
+        for (const auto& it : gLiveOutputs) {
+            dst << sep << it;
+            sep = ",";
+        }
+        dst << " ";
+    }
+    for (const auto& it : gFrozenControls) dst << "-fzc " << it.first << "=" << it.second << " ";
+    if (gControlRateInterp > 0) dst << "-cri " << gControlRateInterp << " ";
     dst << "-es " << gEnableFlag << " ";
     if (gHasExp10) dst << "-exp10 ";
     if (gSchedulerSwitch) dst << "-sch ";
@@ -682,6 +717,15 @@ void global::printCompilationOptions(stringstream& dst, bool backend)
     dst << "-mcd " << gGlobal->gMaxCopyDelay << " ";
     if (gGlobal->gUIMacroSwitch) dst << "-uim ";
     dst << printFloat() << "-ftz " << gFTZMode << " ";
+    if (gFTZVars.size() > 0) {
+        dst << "-ftzv ";
+        string sep = "";
+        for (const auto& it : gFTZVars) {
+            dst << sep << it;
+            sep = ",";
+        }
+        dst << " ";
+    }
     if (gVectorSwitch) {
         dst << "-vec "
             << "-lv " << gVectorLoopVariant << " "
@@ -137,7 +137,10 @@ struct global {
     bool gUIMacroSwitch;
     bool gDumpNorm;
     int  gFTZMode;
+    set<string> gFTZVars;  // Recursive variables actually wrapped with FTZ code (all when empty), see -ftzv
+    set<string> gFTZFoundVars;  // -ftzv variables found in the compiled recursions
     bool gRangeUI;  // whether to generate code to limit vslider/hslider/nentry values in [min..max] range
+    bool gHotColdStruct;  // whether to order the DSP struct fields by access in 'compute'
 
     int gFloatSize;
 
@@ -165,6 +168,15 @@ struct global {
     bool   gComputeIOTA;           // Cache some computation done with IOTA variable
     bool   gFAUSTFLOAT2Internal;   // FAUSTFLOAT type (= kFloatMacro) forced to internal real
     bool   gInPlace;               // Add cache to input for correct in-place computations
+    bool   gMultiVersioning;       // Compile 'compute' for several CPU targets selected at load time (C++ backend)
+    bool   gProfileLoops;          // Measure the parts of 'compute' with a cycle counter (C++ backend)
+    int    gLLVMVectorWidth;       // LLVM vectorizer width hint (0 = chosen by LLVM)
+    int    gLLVMInterleaveCount;   // LLVM vectorizer interleave count hint (0 = chosen by LLVM)
+    int    gLLVMUnrollCount;       // LLVM loop unroll count hint (0 = chosen by LLVM)
+    int    gLLVMInlineThreshold;   // LLVM inliner threshold (-1 = depending of the optimization level)
+    bool   gLLVMSLP;               // Force LLVM SLP vectorization at all optimization levels
+    bool   gLLVMFastInit;          // Do not optimize the LLVM initialization functions
+    bool   gWASMSIMD;              // Compile the non-recursive vector loops with SIMD128 instructions (wasm backend)
     bool   gHasExp10;              // If the 'exp10' math function is available
     bool   gLoopVarInBytes;        // If the 'i' variable used in the scalar loop moves by bytes instead of frames
     bool   gWaveformInDSP;         // If waveform are allocated in the DSP and not as global data
@@ -512,6 +524,13 @@ struct global {
     int gAllocationCount;  // Internal signal types counter
 
     int gMaskDelayLineThreshold;  // Power-of-two and mask delay-lines treshold
+    int gMaskDelayLineWaste;      // Max unused part (in %) of a power-of-two and mask delay-line
+    pair<int, int> gDelayLinesSize;  // Delay-lines size in bytes: <allocated, with power-of-two ring buffers only>
+
+    set<int>            gLiveOutputs;     // Outputs actually computed (all when empty), see -lo
+    map<string, double> gFrozenControls;  // Controls replaced by a constant value (label or path, value), see -fzc
+
+    int gControlRateInterp;  // Sub-block size of interpolated control rate expressions (0 when disabled), see -cri
 
     bool gEnableFlag;
 
@@ -590,6 +609,18 @@ struct global {
     string makeDrawPath();
     string makeDrawPathNoExt();
 
+    // The file implementing the -fm functions, 'def' and 'poly' select the ones of the architecture folder
+    string getFastMathFile()
+    {
+        if (gFastMathLib == "def") {
+            return "faust/dsp/fastmath.cpp";
+        } else if (gFastMathLib == "poly") {
+            return "faust/dsp/fastmath-poly.cpp";
+        } else {
+            return gFastMathLib;
+        }
+    }
+
     string getMathFunction(const string& name)
     {
         if (gFastMath && (gFastMathLibTable.find(name) != gFastMathLibTable.end())) {
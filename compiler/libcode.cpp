@@ -426,6 +426,48 @@ static bool processCmdline(int argc, const char* argv[])
             gGlobal->gMaskDelayLineThreshold = std::atoi(argv[i + 1]);
             i += 2;
 
+        } else if (isCmd(argv[i], "-dlw", "--delay-line-waste") && (i + 1 < argc)) {
+            gGlobal->gMaskDelayLineWaste = std::atoi(argv[i + 1]);
+            i += 2;
+
+        } else if (isCmd(argv[i], "-lo", "--live-outputs") && (i + 1 < argc)) {
+            stringstream outputs(argv[i + 1]);
+            string       output;
+            while (getline(outputs, output, ',')) {
+                char* end   = nullptr;
+                long  index = std::strtol(output.c_str(), &end, 10);
+                if (output.empty() || *end != '\0') {
+                    stringstream error;
+                    error << "ERROR : invalid -lo option (comma separated output indexes expected): " << argv[i + 1] << endl;
+                    throw faustexception(error.str());
+                }
+                gGlobal->gLiveOutputs.insert(int(index));
+            }
+            i += 2;
+
+        } else if (isCmd(argv[i], "-fzc", "--freeze-control") && (i + 1 < argc)) {
+            string control = argv[i + 1];
+            size_t pos     = control.rfind('=');
+            if (pos == string::npos) {
+                stringstream error;
+                error << "ERROR : invalid -fzc option (<label or path>=<value> expected): " << control << endl;
+                throw faustexception(error.str());
+            }
+            string value = control.substr(pos + 1);
+            char*  end   = nullptr;
+            double res   = std::strtod(value.c_str(), &end);
+            if (value.empty() || *end != '\0') {
+                stringstream error;
+                error << "ERROR : invalid -fzc option (<label or path>=<value> expected): " << control << endl;
+                throw faustexception(error.str());
+            }
+            gGlobal->gFrozenControls[control.substr(0, pos)] = res;
+            i += 2;
+
+        } else if (isCmd(argv[i], "-cri", "--control-rate-interpolation") && (i + 1 < argc)) {
+            gGlobal->gControlRateInterp = std::atoi(argv[i + 1]);
+            i += 2;
+
         } else if (isCmd(argv[i], "-mem", "--memory-manager")) {
             gGlobal->gMemoryManager = true;
             i += 1;
@@ -494,6 +536,10 @@ static bool processCmdline(int argc, const char* argv[])
             gTimingSwitch = true;
             i += 1;
 
+        } else if (isCmd(argv[i], "-time-json", "--compilation-time-json") && (i + 1 < argc)) {
+            setTimingJSONFile(argv[i + 1]);
+            i += 2;
+
             // 'real' options
         } else if (isCmd(argv[i], "-single", "--single-precision-floats")) {
             if (float_size && gGlobal->gFloatSize != 1) {
@@ -605,10 +651,22 @@ static bool processCmdline(int argc, const char* argv[])
             }
             i += 2;
 
+        } else if (isCmd(argv[i], "-ftzv", "--flush-to-zero-vars") && (i + 1 < argc)) {
+            stringstream vars(argv[i + 1]);
+            string       var;
+            while (getline(vars, var, ',')) {
+                if (var != "") gGlobal->gFTZVars.insert(var);
+            }
+            i += 2;
+
         } else if (isCmd(argv[i], "-rui", "--range-ui")) {
             gGlobal->gRangeUI = true;
             i += 1;
 
+        } else if (isCmd(argv[i], "-hcs", "--hot-cold-struct")) {
+            gGlobal->gHotColdStruct = true;
+            i += 1;
+
         } else if (isCmd(argv[i], "-fm", "--fast-math")) {
             gGlobal->gFastMath    = true;
             gGlobal->gFastMathLib = argv[i + 1];
@@ -668,6 +726,42 @@ static bool processCmdline(int argc, const char* argv[])
             gGlobal->gInPlace = true;
             i += 1;
 
+        } else if (isCmd(argv[i], "-fmv", "--function-multi-versioning")) {
+            gGlobal->gMultiVersioning = true;
+            i += 1;
+
+        } else if (isCmd(argv[i], "-prof", "--profile-loops")) {
+            gGlobal->gProfileLoops = true;
+            i += 1;
+
+        } else if (isCmd(argv[i], "-lvw", "--llvm-vector-width") && (i + 1 < argc)) {
+            gGlobal->gLLVMVectorWidth = std::atoi(argv[i + 1]);
+            i += 2;
+
+        } else if (isCmd(argv[i], "-lic", "--llvm-interleave-count") && (i + 1 < argc)) {
+            gGlobal->gLLVMInterleaveCount = std::atoi(argv[i + 1]);
+            i += 2;
+
+        } else if (isCmd(argv[i], "-luc", "--llvm-unroll-count") && (i + 1 < argc)) {
+            gGlobal->gLLVMUnrollCount = std::atoi(argv[i + 1]);
+            i += 2;
+
+        } else if (isCmd(argv[i], "-lit", "--llvm-inline-threshold") && (i + 1 < argc)) {
+            gGlobal->gLLVMInlineThreshold = std::atoi(argv[i + 1]);
+            i += 2;
+
+        } else if (isCmd(argv[i], "-lslp", "--llvm-slp")) {
+            gGlobal->gLLVMSLP = true;
+            i += 1;
+
+        } else if (isCmd(argv[i], "-lfi", "--llvm-fast-init")) {
+            gGlobal->gLLVMFastInit = true;
+            i += 1;
+
+        } else if (isCmd(argv[i], "-wsimd", "--wasm-simd")) {
+            gGlobal->gWASMSIMD = true;
+            i += 1;
+
         } else if (isCmd(argv[i], "-es", "--enable-semantics")) {
             gGlobal->gEnableFlag = std::atoi(argv[i + 1]) == 1;
             i += 2;
@@ -732,6 +826,33 @@ static bool processCmdline(int argc, const char* argv[])
         throw faustexception("ERROR : '-inpl' option can only be used in scalar mode\n");
     }
 
+    if (gGlobal->gMultiVersioning &&
+        (gGlobal->gOutputLang != "cpp" || gGlobal->gOneSample >= 0 || gGlobal->gOpenMPSwitch || gGlobal->gSchedulerSwitch)) {
+        throw faustexception("ERROR : '-fmv' option can only be used with the 'cpp' backend, in scalar or vector mode\n");
+    }
+
+    if (gGlobal->gProfileLoops &&
+        (gGlobal->gOutputLang != "cpp" || gGlobal->gOneSample >= 0 || gGlobal->gOpenMPSwitch || gGlobal->gSchedulerSwitch)) {
+        throw faustexception("ERROR : '-prof' option can only be used with the 'cpp' backend, in scalar or vector mode\n");
+    }
+
+    if ((gGlobal->gLLVMVectorWidth > 0 || gGlobal->gLLVMInterleaveCount > 0 || gGlobal->gLLVMUnrollCount > 0 ||
+         gGlobal->gLLVMInlineThreshold >= 0 || gGlobal->gLLVMSLP || gGlobal->gLLVMFastInit) &&
+        gGlobal->gOutputLang != "llvm") {
+        throw faustexception("ERROR : -lvw, -lic, -luc, -lit, -lslp and -lfi options can only be used with the 'llvm' backend\n");
+    }
+
+#if defined(LLVM_BUILD) && (LLVM_VERSION_MAJOR == 14)
+    // The LLVM 14 new pass manager default pipeline does not allow to change its inliner threshold
+    if (gGlobal->gLLVMInlineThreshold >= 0) {
+        throw faustexception("ERROR : -lit option cannot be used with LLVM 14, use LLVM 15 or later\n");
+    }
+#endif
+
+    if (gGlobal->gWASMSIMD && (!startWith(gGlobal->gOutputLang, "wasm") || !gGlobal->gVectorSwitch)) {
+        throw faustexception("ERROR : '-wsimd' option can only be used with the 'wasm' backend in vector mode\n");
+    }
+
 #if 0
     if (gGlobal->gOutputLang == "ocpp" && gGlobal->gVectorSwitch) {
         throw faustexception("ERROR : 'ocpp' backend can only be used in scalar mode\n");
@@ -750,6 +871,14 @@ static bool processCmdline(int argc, const char* argv[])
         throw faustexception("ERROR : '-ftz 2' option cannot be used in 'soul' backend\n");
     }
 
+    if (gGlobal->gFTZVars.size() > 0 && gGlobal->gFTZMode == 0) {
+        throw faustexception("ERROR : '-ftzv' option can only be used with '-ftz 1' or '-ftz 2'\n");
+    }
+
+    if (gGlobal->gFTZVars.size() > 0 && gGlobal->gOutputLang == "ocpp") {
+        throw faustexception("ERROR : '-ftzv' option cannot be used with the 'ocpp' backend\n");
+    }
+
     if (gGlobal->gVectorLoopVariant < 0 || gGlobal->gVectorLoopVariant > 1) {
         stringstream error;
         error << "ERROR : invalid loop variant [-lv = " << gGlobal->gVectorLoopVariant << "] should be 0 or 1" << endl;
@@ -785,6 +914,28 @@ static bool processCmdline(int argc, const char* argv[])
             "ERROR : '-dlt < INT_MAX' option can only be used in scalar mode and not with the 'ocpp' backend\n");
     }
 
+    if ((gGlobal->gLiveOutputs.size() > 0 || gGlobal->gFrozenControls.size() > 0) && gGlobal->gOutputLang == "ocpp") {
+        throw faustexception("ERROR : -lo and -fzc cannot be used with the 'ocpp' backend\n");
+    }
+
+    if ((gGlobal->gMaskDelayLineWaste < 0) || (gGlobal->gMaskDelayLineWaste > 100)) {
+        throw faustexception("ERROR : '-dlw' option must be in the [0..100] range\n");
+    }
+
+    if (gGlobal->gMaskDelayLineWaste < 100 && (gGlobal->gVectorSwitch || (gGlobal->gOutputLang == "ocpp"))) {
+        throw faustexception(
+            "ERROR : '-dlw < 100' option can only be used in scalar mode and not with the 'ocpp' backend\n");
+    }
+
+    if (gGlobal->gControlRateInterp < 0) {
+        throw faustexception("ERROR : '-cri' option must be a positive number\n");
+    }
+
+    if (gGlobal->gControlRateInterp > 1 && (gGlobal->gVectorSwitch || (gGlobal->gOutputLang == "ocpp"))) {
+        throw faustexception(
+            "ERROR : '-cri' option can only be used in scalar mode and not with the 'ocpp' backend\n");
+    }
+
     // gComputeMix check
     if (gGlobal->gComputeMix && gGlobal->gOutputLang == "ocpp") {
         throw faustexception("ERROR : -cm cannot be used with the 'ocpp' backend\n");
@@ -916,7 +1067,7 @@ static void printHelp()
     cout << tab << "-uim      --user-interface-macros       add user interface macro definitions to the output code."
          << endl;
     cout << tab << "-xml                                    generate an XML description file." << endl;
-    cout << tab << "-json                                   generate a JSON description file." << endl;
+    cout << tab << "-json                                   generate a JSON description file, with the DSP cache footprint." << endl;
     cout << tab
          << "-O <dir>  --output-dir <dir>            specify the relative directory of the generated output code and "
             "of additional generated files (SVG, XML...)."
@@ -973,6 +1124,22 @@ static void printHelp()
             "(default INT_MAX "
             "samples)."
          << endl;
+    cout << tab
+         << "-dlw <n>    --delay-line-waste <n>      max unused part (in %) of a 'mask' ring buffer before using the 'select' "
+            "implementation (default 100)."
+         << endl;
+    cout << tab
+         << "-lo <l>     --live-outputs <l>          only compute the outputs in the comma separated <l> list, the "
+            "others are set to 0."
+         << endl;
+    cout << tab
+         << "-fzc <c=v>  --freeze-control <c=v>      replace the control <c> (label or JSON address) by the constant "
+            "value <v>."
+         << endl;
+    cout << tab
+         << "-cri <n>    --control-rate-interpolation <n> compute expensive functions of smoothed controls every <n> "
+            "samples and linearly interpolate in between."
+         << endl;
     cout << tab
          << "-mem        --memory-manager            allocate static in global state using a custom memory manager."
          << endl;
@@ -980,10 +1147,18 @@ static void printHelp()
          << "-ftz <n>    --flush-to-zero <n>         code added to recursive signals [0:no (default), 1:fabs based, "
             "2:mask based (fastest)]."
          << endl;
+    cout << tab
+         << "-ftzv <l>   --flush-to-zero-vars <l>    only add the -ftz code to the recursive variables in the comma "
+            "separated <l> list (like fRec3,fRec7)."
+         << endl;
     cout << tab
          << "-rui        --range-ui                  whether to generate code to limit vslider/hslider/nentry values "
             "in [min..max] range."
          << endl;
+    cout << tab
+         << "-hcs        --hot-cold-struct           order the DSP struct fields so that the ones used for each sample "
+            "come first, then the ones used once per block, then the others."
+         << endl;
     cout
         << tab
         << "-inj <f>    --inject <f>                inject source file <f> into architecture file instead of compiling "
@@ -994,6 +1169,37 @@ static void printHelp()
          << "-inpl       --in-place                  generates code working when input and output buffers are the same "
             "(scalar mode only)."
          << endl;
+    cout << tab
+         << "-fmv        --function-multi-versioning compile 'compute' for several CPU targets (AVX512, AVX2, default), "
+            "the best one being selected at load time (cpp backend only)."
+         << endl;
+    cout << tab
+         << "-prof       --profile-loops             accumulate the cycles spent in the control code and in each loop of 'compute', "
+            "returned by the 'profile' method (cpp backend only)."
+         << endl;
+    cout << tab
+         << "-lvw <n>    --llvm-vector-width <n>     vectorize the non-recursive loops of the vector mode with width <n> "
+            "(llvm backend only)."
+         << endl;
+    cout << tab
+         << "-lic <n>    --llvm-interleave-count <n> interleave the vectorized loops <n> times (llvm backend only)."
+         << endl;
+    cout << tab << "-luc <n>    --llvm-unroll-count <n>     unroll the loops <n> times (llvm backend only)." << endl;
+    cout << tab
+         << "-lit <n>    --llvm-inline-threshold <n> use <n> as the LLVM inliner threshold (llvm backend only, not with LLVM 14)."
+         << endl;
+    cout << tab
+         << "-lslp       --llvm-slp                  do SLP vectorization at all LLVM optimization levels (llvm backend "
+            "only)."
+         << endl;
+    cout << tab
+         << "-lfi        --llvm-fast-init            do not optimize the initialization functions to reduce JIT compilation "
+            "time (llvm backend only)."
+         << endl;
+    cout << tab
+         << "-wsimd      --wasm-simd                 compile the non-recursive vector loops with SIMD128 instructions "
+            "(wasm backend in -vec mode only)."
+         << endl;
     cout << tab << "-vec        --vectorize                 generate easier to vectorize code." << endl;
     cout << tab << "-vs <n>     --vec-size <n>              size of the vector (default 32 samples)." << endl;
     cout << tab << "-lv <n>     --loop-variant <n>          [0:fastest (default), 1:simple]." << endl;
@@ -1017,7 +1223,8 @@ static void printHelp()
          << endl;
     cout << tab
          << "-fm <file>  --fast-math <file>          use optimized versions of mathematical functions implemented in "
-            "<file>, use 'faust/dsp/fastmath.cpp' when file is 'def'."
+            "<file>, use 'faust/dsp/fastmath.cpp' when file is 'def', and the vectorizable "
+            "'faust/dsp/fastmath-poly.cpp' when file is 'poly'."
          << endl;
     cout << tab
 
@@ -1073,6 +1280,8 @@ static void printHelp()
     cout << endl << "Debug options:" << line;
     cout << tab << "-d          --details                   print compilation details." << endl;
     cout << tab << "-time       --compilation-time          display compilation phases timing information." << endl;
+    cout << tab << "-time-json <f> --compilation-time-json <f> write compilation phases timing and memory counters in <f> (Chrome trace event format)."
+         << endl;
     cout << tab << "-flist      --file-list                 print file list (including libraries) used to eval process."
          << endl;
     cout << tab << "-tg         --task-graph                print the internal task graph in dot format." << endl;
@@ -1957,7 +2166,9 @@ static void generateCode(Tree signals, int numInputs, int numOutputs, bool gener
      ****************************************************************/
 
     if (new_comp) {
+        startTiming("produceCode");
         generateCodeAux1(dst);
+        endTiming("produceCode");
     }
 #ifdef OCPP_BUILD
     else if (old_comp) {
@@ -2187,6 +2398,8 @@ static void createFactoryAux(const char* name, const char* dsp_content, int argc
 
     faust_alarm(gGlobal->gTimeout);
 
+    startTiming("compile");
+
     /****************************************************************
      1.5 - Check and open some input files
     *****************************************************************/
@@ -2253,6 +2466,7 @@ static void createFactoryAux(const char* name, const char* dsp_content, int argc
         boxppShared::printIDs(out);
         out << "process = " << s.str() << ';' << endl;
         
+        endTiming("compile");
         return;
     }
 
@@ -2284,6 +2498,8 @@ static void createFactoryAux(const char* name, const char* dsp_content, int argc
      6 - generate xml description, documentation or dot files
     *****************************************************************/
     generateOutputFiles();
+
+    endTiming("compile");
 }
 
 static void createFactoryAux(const char* name, Tree signals, int argc, const char* argv[], int numInputs, int numOutputs, bool generate)
@@ -2301,8 +2517,10 @@ static void createFactoryAux(const char* name, Tree signals, int argc, const cha
      5 - preparation of the signal tree and translate output signals
      **************************************************************************/
     
+    startTiming("compile");
     gGlobal->gMetaDataSet[tree("name")].insert(tree(quote(name)));
     generateCode(signals, numInputs, numOutputs, generate);
+    endTiming("compile");
 }
 
 // ============
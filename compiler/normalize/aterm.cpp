@@ -19,6 +19,8 @@
  ************************************************************************
  ************************************************************************/
 
+#include <algorithm>
+
 #include "aterm.hh"
 #include "ppsig.hh"
 #include "sigtype.hh"
@@ -287,24 +289,56 @@ const aterm& aterm::operator-=(const mterm& m)
     return *this;
 }
 
+/**
+ * Return the greatest common divisor of two of the mterms (the first pair in the
+ * mterms order when several have the same complexity). Only the pairs that
+ * may have a divisor of non null complexity are tried: the ones sharing a factor,
+ * and for each mterm, the first following one with a coefficient of same magnitude.
+ * This avoids trying all the pairs of large sums of unrelated terms (like mixers).
+ */
 mterm aterm::greatestDivisor() const
 {
     int   maxComplexity = 0;
     mterm maxGCD(1);
     // cerr << "greatestDivisor of " << *this << endl;
 
-    for (SM::const_iterator p1 = fSig2MTerms.begin(); p1 != fSig2MTerms.end(); p1++) {
-        for (SM::const_iterator p2 = p1; p2 != fSig2MTerms.end(); p2++) {
-            if (p2 != p1) {
-                mterm g = gcd(p1->second, p2->second);
-                // cerr << "TRYING " << g << " of complexity " << g.complexity() << " (max complexity so far " <<
-                // maxComplexity << ")" << endl;
-                if (g.complexity() > maxComplexity) {
-                    maxComplexity = g.complexity();
-                    maxGCD        = g;
+    vector<const mterm*>                   terms;
+    map<Tree, vector<size_t>, CompareTree> factor2terms;
+    for (const auto& p : fSig2MTerms) {
+        for (const auto& f : p.second.factors()) {
+            factor2terms[f.first].push_back(terms.size());
+        }
+        terms.push_back(&p.second);
+    }
+
+    for (size_t i = 0; i < terms.size(); i++) {
+        // Collect the candidates following i, in the mterms order
+        vector<size_t> candidates;
+        for (const auto& f : terms[i]->factors()) {
+            const vector<size_t>& v = factor2terms[f.first];
+            candidates.insert(candidates.end(), upper_bound(v.begin(), v.end(), i), v.end());
+        }
+        Tree c = terms[i]->coef();
+        if (!isOne(c) && !isMinusOne(c)) {
+            for (size_t j = i + 1; j < terms.size(); j++) {
+                if (sameMagnitude(c, terms[j]->coef())) {
+                    candidates.push_back(j);
+                    break;
                 }
             }
         }
+        sort(candidates.begin(), candidates.end());
+        candidates.erase(unique(candidates.begin(), candidates.end()), candidates.end());
+
+        for (size_t j : candidates) {
+            mterm g = gcd(*terms[i], *terms[j]);
+            // cerr << "TRYING " << g << " of complexity " << g.complexity() << " (max complexity so far " <<
+            // maxComplexity << ")" << endl;
+            if (g.complexity() > maxComplexity) {
+                maxComplexity = g.complexity();
+                maxGCD        = g;
+            }
+        }
     }
     // cerr << "greatestDivisor of " << *this << " --> " << maxGCD << endl;
     return maxGCD;
@@ -77,6 +77,8 @@ class mterm : public virtual Garbageable {
     ostream& print(ostream& dst) const;        ///< print a mterm k*x1**n1*x2**n2...
 
     int  complexity() const;  ///< return an evaluation of the complexity
+    Tree coef() const { return fCoef; }  ///< return the constant part of the term
+    const map<Tree, int, CompareTree>& factors() const { return fFactors; }  ///< return the non constant terms
     Tree normalizedTree(bool sign = false,
                         bool neg  = false) const;  ///< return the normalized tree of the mterm
     Tree signatureTree() const;                    ///< return a signature (a normalized tree)
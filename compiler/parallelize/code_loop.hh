@@ -65,6 +65,7 @@ class CodeLoop : public virtual Garbageable {
    private:
     bool            fIsRecursive;    ///< recursive loops can't be SIMDed
     Tree            fRecSymbolSet;   ///< recursive loops define a set of recursive symbol
+    Tree            fSignal;         ///< the signal computed by the loop (used to label it)
     CodeLoop* const fEnclosingLoop;  ///< Loop from which this one originated
     int             fSize;           ///< number of iterations of the loop
     int             fOrder;          ///< used during topological sort
@@ -106,6 +107,7 @@ class CodeLoop : public virtual Garbageable {
     CodeLoop(Tree recsymbol, CodeLoop* encl, const string& index_name, int size = 0)
         : fIsRecursive(true),
           fRecSymbolSet(singleton(recsymbol)),
+          fSignal(gGlobal->nil),
           fEnclosingLoop(encl),
           fSize(size),
           fOrder(-1),
@@ -122,6 +124,7 @@ class CodeLoop : public virtual Garbageable {
     CodeLoop(CodeLoop* encl, const string& index_name, int size = 0)
         : fIsRecursive(false),
           fRecSymbolSet(gGlobal->nil),
+          fSignal(gGlobal->nil),
           fEnclosingLoop(encl),
           fSize(size),
           fOrder(-1),
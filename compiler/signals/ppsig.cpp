@@ -178,6 +178,9 @@ ostream& ppsig::print(ostream& fout) const
     double r;
     Tree   c, sel, x, y, z, u, var, le, label, id, ff, largs, type, name, file, sf;
 
+    // Stop going down the signal when the stream cannot be written anymore (like a size limited one)
+    if (!fout.good()) return fout;
+
     if (isList(sig)) {
         printlist(fout, sig);
     } else if (isProj(sig, &i, x)) {
@@ -927,6 +927,16 @@ Tree sigFTZ(Tree s)
     return tree(gGlobal->gFtzPrim->symbol(), s);
 }
 
+bool isSigFTZ(Tree t, Tree& x)
+{
+    if ((t->node() == Node(gGlobal->gFtzPrim->symbol())) && (t->arity() == 1)) {
+        x = t->branch(0);
+        return true;
+    } else {
+        return false;
+    }
+}
+
 /*****************************************************************************
  *                          sigList2vectInt
  *****************************************************************************/
@@ -342,6 +342,7 @@ Tree sigCartesianProd(Tree s1, Tree s2);
 *****************************************************************************/
 
 Tree sigFTZ(Tree s);
+bool isSigFTZ(Tree t, Tree& x);
 
 /*****************************************************************************
                              Access to sub signals of a signal
@@ -217,6 +217,22 @@ void CTree::control()
     printf("\nEnd gHashTable\n");
 }
 
+void CTree::statistics(size_t& trees, size_t& buckets, size_t& properties)
+{
+    trees      = 0;
+    buckets    = 0;
+    properties = 0;
+    for (int i = 0; i < kHashTableSize; i++) {
+        Tree t = gHashTable[i];
+        if (t) buckets++;
+        while (t) {
+            trees++;
+            properties += t->fProperties.size();
+            t = t->fNext;
+        }
+    }
+}
+
 void CTree::init()
 {
     memset(gHashTable, 0, sizeof(Tree) * kHashTableSize);
@@ -153,6 +153,9 @@ class LIBFAUST_API CTree : public virtual Garbageable {
     // Print a tree and the hash table (for debugging purposes)
     ostream&    print(ostream& fout) const;  ///< print recursively the content of a tree on a stream
     static void control();                   ///< print the hash table content (for debug purpose)
+    static void statistics(size_t& trees, size_t& buckets,
+                           size_t& properties);  ///< count the live trees, used hash table entries and properties
+    static size_t hashTableSize() { return kHashTableSize; }
 
     static void init();
 
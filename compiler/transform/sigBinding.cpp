@@ -0,0 +1,158 @@
+/************************************************************************
+ ************************************************************************
+    FAUST compiler
+    Copyright (C) 2003-2018 GRAME, Centre National de Creation Musicale
+    ---------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ ************************************************************************
+ ************************************************************************/
+
+#include <sstream>
+
+#include "description.hh"
+#include "exception.hh"
+#include "global.hh"
+#include "labels.hh"
+#include "signals.hh"
+#include "signalVisitor.hh"
+#include "sigBinding.hh"
+#include "Text.hh"
+
+/********************************************************************
+SignalBinding::getFrozenValue(Tree path, double& value) :
+
+A control is frozen when its label, or its complete path built as
+the JSON/UI address ('/group1/group2/label'), is a key of fFrozenControls.
+**********************************************************************/
+
+static string stripLabel(const string& fulllabel)
+{
+    string                   label;
+    map<string, set<string>> metadata;
+    extractMetadata(fulllabel, label, metadata);
+    size_t first = label.find_first_not_of(' ');
+    size_t last  = label.find_last_not_of(' ');
+    return (first == string::npos) ? "" : label.substr(first, last - first + 1);
+}
+
+// The outermost group of a path (a list: the widget label first, then the enclosing groups), or nil
+static Tree outermostGroup(Tree path)
+{
+    Tree res = gGlobal->nil;
+    for (Tree group = tl(path); isList(group); group = tl(group)) {
+        if (isList(hd(group))) res = hd(group);
+    }
+    return res;
+}
+
+// Collect the paths of all user interface elements
+class UIPathCollector : public SignalVisitor {
+   public:
+    vector<Tree> fPaths;
+
+   protected:
+    void visit(Tree sig) override
+    {
+        Tree path, c, x, y, z;
+        if (isSigButton(sig, path) || isSigCheckbox(sig, path) || isSigVSlider(sig, path, c, x, y, z) ||
+            isSigHSlider(sig, path, c, x, y, z) || isSigNumEntry(sig, path, c, x, y, z) ||
+            isSigVBargraph(sig, path, x, y, z) || isSigHBargraph(sig, path, x, y, z) || isSigSoundfile(sig, path)) {
+            fPaths.push_back(path);
+        }
+        SignalVisitor::visit(sig);
+    }
+};
+
+bool SignalBinding::getFrozenValue(Tree path, double& value)
+{
+    // The path is a list: the widget label first, then the enclosing groups
+    string label = stripLabel(tree2str(hd(path)));
+    string fullpath;
+    for (Tree group = tl(path); isList(group); group = tl(group)) {
+        Tree elem = hd(group);
+        if (isList(elem)) {
+            fullpath = "/" + stripLabel(tree2str(tl(elem))) + fullpath;
+        }
+    }
+    fullpath = fRootPath + fullpath + "/" + label;
+    // Same characters replacement as in PathBuilder::buildPath
+    for (auto& c : fullpath) {
+        if (string(" #*,?[]{}()").find(c) != string::npos) c = '_';
+    }
+
+    auto it = fFrozenControls.find(fullpath);
+    if (it == fFrozenControls.end()) it = fFrozenControls.find(label);
+    if (it != fFrozenControls.end()) {
+        fMatchedControls.insert(it->first);
+        value = it->second;
+        return true;
+    } else {
+        return false;
+    }
+}
+
+Tree SignalBinding::bind(Tree lsig)
+{
+    if (fFrozenControls.size() > 0) {
+        // As in InstructionsCompiler::prepareUserInterfaceTree, the UI is enclosed in a root group
+        // named after the DSP, unless all elements are already in the same top-level group
+        UIPathCollector collector;
+        collector.mapself(lsig);
+        Tree top = (collector.fPaths.size() > 0) ? outermostGroup(collector.fPaths[0]) : gGlobal->nil;
+        bool root = isNil(top);
+        for (const auto& path : collector.fPaths) {
+            if (outermostGroup(path) != top) root = true;
+        }
+        fRootPath = (root) ? "/" + unquote(tree2str(*(gGlobal->gMetaDataSet[tree("name")].begin()))) : "";
+    }
+
+    tvec outputs;
+    for (int i = 0; isList(lsig); i++, lsig = tl(lsig)) {
+        if (fLiveOutputs.empty() || fLiveOutputs.count(i) > 0) {
+            outputs.push_back(self(hd(lsig)));
+        } else {
+            outputs.push_back(sigReal(0.0));
+        }
+    }
+    for (const auto& it : fLiveOutputs) {
+        if (it < 0 || it >= int(outputs.size())) {
+            stringstream error;
+            error << "ERROR : live output " << it << " is out of range [0.." << outputs.size() << "[" << endl;
+            throw faustexception(error.str());
+        }
+    }
+    for (const auto& it : fFrozenControls) {
+        if (fMatchedControls.count(it.first) == 0) {
+            stringstream error;
+            error << "ERROR : frozen control '" << it.first << "' does not match any control label or path" << endl;
+            throw faustexception(error.str());
+        }
+    }
+    return listConvert(outputs);
+}
+
+Tree SignalBinding::transformation(Tree sig)
+{
+    Tree   path, c, x, y, z;
+    double value;
+
+    if ((isSigButton(sig, path) || isSigCheckbox(sig, path) || isSigVSlider(sig, path, c, x, y, z) ||
+         isSigHSlider(sig, path, c, x, y, z) || isSigNumEntry(sig, path, c, x, y, z)) &&
+        getFrozenValue(path, value)) {
+        return sigReal(value);
+    } else {
+        return SignalIdentity::transformation(sig);
+    }
+}
@@ -0,0 +1,61 @@
+/************************************************************************
+ ************************************************************************
+    FAUST compiler
+    Copyright (C) 2003-2018 GRAME, Centre National de Creation Musicale
+    ---------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ ************************************************************************
+ ************************************************************************/
+
+#ifndef __SIGBINDING__
+#define __SIGBINDING__
+
+#include <map>
+#include <set>
+#include <string>
+
+#include "sigIdentity.hh"
+
+//-------------------------SignalBinding-------------------------------
+// Specialize a DSP for a given instance configuration (see -lo and -fzc):
+// - controls frozen at a fixed value are replaced by constants
+// - outputs that are not connected are replaced by 0
+// Dead subgraphs are then removed by the following simplification and
+// constant propagation steps.
+//---------------------------------------------------------------------
+
+class SignalBinding : public SignalIdentity {
+   private:
+    const std::set<int>&                 fLiveOutputs;
+    const std::map<std::string, double>& fFrozenControls;
+    std::set<std::string>                fMatchedControls;  // Keys of fFrozenControls used for at least one control
+    std::string                          fRootPath;         // '/name' when the UI is enclosed in the DSP root group
+
+    bool getFrozenValue(Tree path, double& value);
+
+   public:
+    SignalBinding(const std::set<int>& live_outputs, const std::map<std::string, double>& frozen_controls)
+        : fLiveOutputs(live_outputs), fFrozenControls(frozen_controls)
+    {
+    }
+
+    // Transform the list of output signals
+    Tree bind(Tree lsig);
+
+   protected:
+    virtual Tree transformation(Tree sig);
+};
+
+#endif
@@ -0,0 +1,276 @@
+#!/usr/bin/env python3
+# Measure how the Faust compiler time and memory grow with the size of generated stress DSPs
+import os
+import sys
+import math
+import json
+import argparse
+import subprocess
+import time
+
+###########################################
+# Generators: each one returns the DSP code for the size n
+###########################################
+
+def gen_mixer(n):
+    # n mono channels with gain and pan, mixed on a stereo bus
+    return """// %d channels mixer
+strip(i) = *(g) <: *(1-p), *(p)
+with {
+    g = hslider("h:mixer/v:[%%2i]ch%%2i/gain", 0.5, 0, 1, 0.01) : si;
+    p = hslider("h:mixer/v:[%%2i]ch%%2i/pan", 0.5, 0, 1, 0.01) : si;
+    si = *(0.001) : +~*(0.999);
+};
+process = par(i, %d, strip(i)) :> _,_;
+""" % (n, n)
+
+def gen_filterbank(n):
+    # n bands in parallel, each one made of 2 cascaded band-pass biquads
+    return """// %d bands filter bank
+biquad(b0,b1,b2,a1,a2) = + ~ conv2(-a1,-a2) : conv3(b0,b1,b2)
+with {
+    conv2(c0,c1,x) = c0*x + c1*x';
+    conv3(c0,c1,c2,x) = c0*x + c1*x' + c2*x'';
+};
+bandpass(f) = biquad(alpha, 0, -alpha, -2*cs, 1-alpha)
+with {
+    w = 2*3.14159265359*f/ma.SR;
+    cs = cos(w);
+    alpha = sin(w)/(2*4);
+};
+ma = environment { SR = min(192000.0, max(1.0, fconstant(int fSamplingFreq, <math.h>))); };
+band(i) = bandpass(f) : bandpass(f) : *(hslider("band%%3i", 0.5, 0, 1, 0.01))
+with {
+    f = 20*pow(1000, (i+0.5)/%d);
+};
+process = _ <: par(i, %d, band(i)) :> _;
+""" % (n, n, n)
+
+def gen_matrix(n):
+    # n x n gain matrix
+    return """// %d x %d matrix
+cell(i,j) = *(hslider("h:matrix/v:in%%2i/out%%2j", (i==j), 0, 1, 0.01));
+process = par(i, %d, _) <: par(j, %d, par(i, %d, cell(i,j)) :> _);
+""" % (n, n, n, n, n)
+
+def gen_route(n):
+    # a chain of 4 n x n route permutations
+    return """// %d x %d route chain
+perm(k) = route(%d, %d, par(i, %d, (i+1, ((i+k+1)%%%d)+1)));
+process = seq(k, 4, perm(k) : par(i, %d, *(0.5+i*0.001)));
+""" % (n, n, n, n, n, n, n)
+
+def gen_rec(n):
+    # n nested recursions
+    return """// %d nested recursions
+nest(1) = + ~ *(0.5);
+nest(n) = (+ : nest(n-1)) ~ (mem : *(0.5/n));
+process = nest(%d);
+""" % (n, n)
+
+def gen_seq(n):
+    # n stages in series, each one with a one-pole filter and a delay
+    return """// %d stages chain
+stage(i) = + ~ *(0.5 + i*0.0001) : @(i+1) : *(0.9);
+process = seq(i, %d, stage(i));
+""" % (n, n)
+
+GENERATORS = {
+    "mixer": gen_mixer,
+    "filterbank": gen_filterbank,
+    "matrix": gen_matrix,
+    "route": gen_route,
+    "rec": gen_rec,
+    "seq": gen_seq
+}
+
+# Amount of DSP code for the size n, the growth of each stage being measured against it
+WORK = {
+    "matrix": lambda n: n * n
+}
+
+# Default sizes of each generator, chosen so that the largest one compiles in a few seconds
+DEFAULT_SIZES = {
+    "mixer": [16, 32, 64, 128, 256],
+    "filterbank": [8, 16, 32, 64, 128],
+    "matrix": [4, 8, 16, 32, 64],
+    "route": [16, 32, 64, 128, 256],
+    "rec": [4, 8, 16, 32, 64],
+    "seq": [16, 32, 64, 128, 256]
+}
+
+###########################################
+# Measure
+###########################################
+
+def read_trace(trace_file):
+    # Sum the duration (in ms) and keep the peak RSS (in KB) of each span of the -time-json trace
+    with open(trace_file) as f:
+        trace = json.load(f)
+    stages = {}
+    order = []
+    base_rss = None
+    for event in trace["traceEvents"]:
+        if event.get("ph") == "C" and event["name"] == "peak RSS (KB)" and base_rss is None:
+            base_rss = event["args"]["value"]
+        if event.get("ph") != "X":
+            continue
+        name = event["name"]
+        if name not in stages:
+            stages[name] = {"time": 0.0, "rss": 0}
+            order.append(name)
+        stages[name]["time"] += event["dur"] / 1000.0
+        stages[name]["rss"] = max(stages[name]["rss"], event["args"].get("peak RSS (KB)", 0))
+    return order, stages, base_rss or 0
+
+def measure(faust, options, dsp_file, trace_file, timeout):
+    cmd = [faust] + options + ["-time-json", trace_file, dsp_file, "-o", os.devnull]
+    start = time.time()
+    try:
+        res = subprocess.run(cmd, capture_output=True, text=True, timeout=timeout)
+    except subprocess.TimeoutExpired:
+        return None, "timeout after %gs" % timeout
+    wall = (time.time() - start) * 1000.0
+    if res.returncode != 0:
+        return None, res.stderr.strip().splitlines()[-1] if res.stderr.strip() else "exit code %d" % res.returncode
+    order, stages, base_rss = read_trace(trace_file)
+    peak_rss = max([s["rss"] for s in stages.values()] + [base_rss])
+    return {"wall": wall, "peak_rss": peak_rss, "base_rss": base_rss, "order": order, "stages": stages}, None
+
+def slope(sizes, values):
+    # Least squares slope of log(value) against log(size): 1 is linear growth, 2 quadratic...
+    points = [(math.log(n), math.log(v)) for n, v in zip(sizes, values) if v > 0]
+    if len(points) < 2:
+        return None
+    mx = sum(p[0] for p in points) / len(points)
+    my = sum(p[1] for p in points) / len(points)
+    num = sum((p[0] - mx) * (p[1] - my) for p in points)
+    den = sum((p[0] - mx) ** 2 for p in points)
+    return num / den if den > 0 else None
+
+def run_generator(args, name, sizes):
+    print("========== %s ==========" % name)
+    runs = []
+    for n in sizes:
+        dsp_file = os.path.join(args.outdir, "%s_%d.dsp" % (name, n))
+        trace_file = os.path.join(args.outdir, "%s_%d.json" % (name, n))
+        with open(dsp_file, "w") as f:
+            f.write(GENERATORS[name](n))
+        res, error = measure(args.faust, args.options.split(), dsp_file, trace_file, args.timeout)
+        if res is None:
+            print("n = %-5d ERROR : %s" % (n, error))
+            # Larger sizes would fail as well
+            break
+        print("n = %-5d %10.1f ms %10d KB" % (n, res["stages"].get("compile", {"time": res["wall"]})["time"], res["peak_rss"]))
+        res["n"] = n
+        runs.append(res)
+    if not runs:
+        return {"sizes": [], "stages": {}, "flagged": []}
+
+    # Stages in their first appearance order
+    order = []
+    for r in runs:
+        for s in r["order"]:
+            if s not in order:
+                order.append(s)
+
+    sizes = [r["n"] for r in runs]
+    work = [WORK.get(name, lambda n: n)(n) for n in sizes]
+    result = {"sizes": sizes, "stages": {}, "flagged": []}
+    print("%-28s" % "stage (ms)" + "".join("%10d" % n for n in sizes) + "%8s" % "slope")
+    for s in order:
+        times = [r["stages"][s]["time"] if s in r["stages"] else 0.0 for r in runs]
+        k = slope(work, times)
+        # Very short stages are only noise
+        flag = k is not None and k > args.threshold and max(times) >= args.min_time
+        print("%-28s" % s[:28] + "".join("%10.1f" % t for t in times)
+              + ("%8.2f" % k if k is not None else "%8s" % "-") + ("  SUPERLINEAR" if flag else ""))
+        result["stages"][s] = {"time": times, "slope": k}
+        if flag:
+            result["flagged"].append(s)
+
+    # Memory used by the compilation, above the memory of the process at startup
+    memory = [max(r["peak_rss"] - r["base_rss"], 1) for r in runs]
+    k = slope(work, memory)
+    flag = k is not None and k > args.threshold and max(memory) >= args.min_memory
+    print("%-28s" % "peak RSS increase (KB)" + "".join("%10d" % m for m in memory)
+          + ("%8.2f" % k if k is not None else "%8s" % "-") + ("  SUPERLINEAR" if flag else ""))
+    result["memory"] = {"peak_rss": [r["peak_rss"] for r in runs], "increase": memory, "slope": k}
+    if flag:
+        result["flagged"].append("memory")
+    return result
+
+def compare(old_file, new_file):
+    # Compare the total compile time and peak RSS of two result files, for the sizes found in both
+    with open(old_file) as f:
+        old = json.load(f)
+    with open(new_file) as f:
+        new = json.load(f)
+    print("%-12s%8s%12s%12s%8s%12s%12s%8s" % ("generator", "n", "old ms", "new ms", "ratio", "old KB", "new KB", "ratio"))
+    for name, res in new["generators"].items():
+        if name not in old["generators"]:
+            continue
+        res_old = old["generators"][name]
+        for i, n in enumerate(res["sizes"]):
+            if n not in res_old["sizes"] or "compile" not in res["stages"] or "compile" not in res_old["stages"]:
+                continue
+            j = res_old["sizes"].index(n)
+            t0 = res_old["stages"]["compile"]["time"][j]
+            t1 = res["stages"]["compile"]["time"][i]
+            m0 = res_old["memory"]["peak_rss"][j]
+            m1 = res["memory"]["peak_rss"][i]
+            print("%-12s%8d%12.1f%12.1f%8.2f%12d%12d%8.2f" % (name, n, t0, t1, t1 / t0 if t0 > 0 else 0, m0, m1, float(m1) / m0 if m0 > 0 else 0))
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate stress DSPs of increasing size, measure the compilation time and peak memory of each compiler stage (using -time-json), and flag the stages growing faster than linearly.")
+    parser.add_argument("-faust", default="faust", help="the faust compiler (default 'faust')")
+    parser.add_argument("-options", default="", help="additional faust options, like '-vec' or '-lang llvm'")
+    parser.add_argument("-gen", default=",".join(GENERATORS.keys()), help="comma separated list of generators among %s (default all)" % ", ".join(GENERATORS.keys()))
+    parser.add_argument("-sizes", default=None, help="comma separated list of sizes, used for all generators (default depends on each generator)")
+    parser.add_argument("-outdir", default="scaling", help="directory for the generated DSPs and traces (default 'scaling')")
+    parser.add_argument("-o", dest="output", default=None, help="write the results in a JSON file")
+    parser.add_argument("-threshold", type=float, default=1.3, help="log-log slope above which a stage is flagged as superlinear (default 1.3)")
+    parser.add_argument("-min-time", type=float, default=10.0, help="do not flag the stages taking less than this time in ms at the largest size (default 10)")
+    parser.add_argument("-min-memory", type=int, default=10000, help="do not flag the memory when it grows less than this in KB at the largest size (default 10000)")
+    parser.add_argument("-timeout", type=float, default=120, help="timeout of each compilation in seconds (default 120)")
+    parser.add_argument("-compare", nargs=2, metavar=("OLD", "NEW"), help="compare two result files and exit")
+    args = parser.parse_args()
+
+    if args.compare:
+        for f in args.compare:
+            if not os.path.isfile(f):
+                sys.exit("ERROR : cannot open '%s'" % f)
+        compare(args.compare[0], args.compare[1])
+        return 0
+
+    names = [g.strip() for g in args.gen.split(",") if g.strip()]
+    for name in names:
+        if name not in GENERATORS:
+            sys.exit("ERROR : unknown generator '%s'" % name)
+    os.makedirs(args.outdir, exist_ok=True)
+
+    results = {"faust": args.faust, "options": args.options, "threshold": args.threshold, "generators": {}}
+    try:
+        results["version"] = subprocess.run([args.faust, "--version"], capture_output=True, text=True).stdout.splitlines()[0]
+    except (OSError, IndexError):
+        sys.exit("ERROR : cannot run '%s'" % args.faust)
+
+    flagged = 0
+    for name in names:
+        sizes = [int(s) for s in args.sizes.split(",")] if args.sizes else DEFAULT_SIZES[name]
+        res = run_generator(args, name, sizes)
+        results["generators"][name] = res
+        flagged += len(res["flagged"])
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(results, f, indent=1)
+
+    print("========== %d superlinear stage(s) ==========" % flagged)
+    for name, res in results["generators"].items():
+        for s in res["flagged"]:
+            print("%s : %s" % (name, s))
+    return 1 if flagged > 0 else 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -13,6 +13,7 @@
 #include "faust/dsp/one-sample-dsp.h"
 #include "faust/gui/GUI.h"
 #include "faust/dsp/poly-dsp.h"
+#include "faust/dsp/arena-memory-manager.h"
 #include "faust/audio/channels.h"
 #include "faust/gui/DecoratorUI.h"
 #include "faust/gui/FUI.h"
@@ -172,9 +173,9 @@ static inline FAUSTFLOAT normalize(FAUSTFLOAT f)
 }
 
 // To be used in static context
-static void runPolyDSP(dsp* dsp, int& linenum, int nbsamples, int num_voices = 4)
+static void runPolyDSP(dsp* dsp, int& linenum, int nbsamples, int num_voices = 4, dsp_memory_manager* manager = nullptr)
 {
-    mydsp_poly* DSP = new mydsp_poly(dsp, num_voices, true, false);
+    mydsp_poly* DSP = new mydsp_poly(dsp, num_voices, true, false, manager);
     
     // Soundfile
     TestMemoryReader memory_reader;
@@ -254,9 +255,12 @@ static void runPolyDSP(dsp* dsp, int& linenum, int nbsamples, int num_voices = 4
 // To be used in dynamic context (LLVM or interp backends)
 static void runPolyDSP1(dsp_factory* factory, int& linenum, int nbsamples, int num_voices = 4, bool is_mem_alloc = false)
 {
-    malloc_memory_manager manager;
+    // All voices are allocated in the arena, and the ones not fitting in with calloc
+    arena_memory_manager manager(1 << 20);
     factory->setMemoryManager((is_mem_alloc) ? &manager : nullptr);
-    runPolyDSP(factory->createDSPInstance(), linenum, nbsamples, num_voices);
+    runPolyDSP(factory->createDSPInstance(), linenum, nbsamples, num_voices, (is_mem_alloc) ? &manager : nullptr);
+    // The arena is deallocated when leaving the function
+    factory->setMemoryManager(nullptr);
 }
 
 // To be used in static context
@@ -0,0 +1,43 @@
+#ifndef FAUSTFLOAT
+#define FAUSTFLOAT double
+#endif
+
+#include "controlTools.h"
+#include "faust/dsp/shared-library-dsp.h"
+
+//----------------------------------------------------------------------------
+// DSP loaded from the 'xxx.so' shared library, 'xxx' being the program name
+//----------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    int linenum = 0;
+    int nbsamples = 60000;
+    
+    string error_msg;
+    shared_library_dsp_factory* factory = readDSPFactoryFromSharedLibrary(string(argv[0]) + ".so", error_msg);
+    if (!factory) {
+        cerr << error_msg;
+        exit(EXIT_FAILURE);
+    }
+    
+    // The same SHA key gives the same factory
+    shared_library_dsp_factory* factory1 = getSharedLibraryDSPFactoryFromSHAKey(factory->getSHAKey());
+    if (factory1 != factory) {
+        cerr << "ERROR : getSharedLibraryDSPFactoryFromSHAKey\n";
+        exit(EXIT_FAILURE);
+    }
+    deleteSharedLibraryDSPFactory(factory1);
+    
+    // print general informations
+    printHeader(factory->createDSPInstance(), nbsamples);
+    
+    // linenum is incremented in runDSP and runPolyDSP
+    runDSP(factory->createDSPInstance(), argv[0], linenum, nbsamples/4);
+    runDSP(factory->createDSPInstance(), argv[0], linenum, nbsamples/4, false, true);
+    runPolyDSP(factory->createDSPInstance(), linenum, nbsamples/4, 4);
+    runPolyDSP(factory->createDSPInstance(), linenum, nbsamples/4, 1);
+    
+    deleteSharedLibraryDSPFactory(factory);
+    return 0;
+}